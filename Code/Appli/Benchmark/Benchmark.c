@@ -0,0 +1,69 @@
+/******************************************************************************************
+  Filename    : Benchmark.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Benchmarks runner
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "ClockFc0.h"
+
+//=============================================================================
+// Globals
+//=============================================================================
+/* measured clk_sys: convert the cycle results with it, not with the nominal frequency */
+volatile uint32 Benchmark_SysClockKhz;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RunCore0 function
+///
+/// \descr  Run the benchmarks on core 0 (called after the multicore synchronization)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_RunCore0(void)
+{
+  Benchmark_SysClockKhz = RP2350_ClockFc0MeasureKhz(CLOCK_FC0_SRC_CLK_SYS, CLOCK_FC0_INTERVAL_32MS);
+
+  Benchmark_LoopJitter();
+  Benchmark_DvfsSwitch();
+  Benchmark_TimerWheel();
+  Benchmark_Delay();
+  Benchmark_CoreTimer();
+  Benchmark_RingProducer();
+  Benchmark_Rpc();
+  Benchmark_Lock();
+  Benchmark_Barrier();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RunCore1 function
+///
+/// \descr  Run the core 1 side of the multicore benchmarks (called after the deferred
+///         init level, with the interrupts of core 1 enabled)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_RunCore1(void)
+{
+  Benchmark_RingConsumer();
+  Benchmark_LockCore1();
+  Benchmark_BarrierCore1();
+}
@@ -0,0 +1,207 @@
+/******************************************************************************************
+  Filename    : Benchmark.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Benchmarks (build with BENCHMARK=1, read the results with the debugger)
+  
+******************************************************************************************/
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  uint32 CopyToRam;   /* 1: copy_to_ram image mode, 0: xip image mode */
+  uint32 Iterations;
+  uint32 MinCycles;
+  uint32 MaxCycles;
+  uint32 AvgCycles;
+  uint32 Jitter;      /* MaxCycles - MinCycles */
+}benchmarkLoopJitter_t;
+
+typedef struct
+{
+  uint32 FromHz;
+  uint32 ToHz;
+  uint32 MinUs;       /* RP2350_ClockDvfsSetSysFreq duration, notifiers included */
+  uint32 MaxUs;
+  uint32 AvgUs;
+}benchmarkDvfsSwitch_t;
+
+#define BENCHMARK_DVFS_SWITCH_NUMBER   4U
+
+typedef struct
+{
+  uint32                Failures;       /* rejected frequency changes */
+  uint32                NotifierCalls;  /* pre + post change notifications */
+  uint32                Repetitions;
+  benchmarkDvfsSwitch_t Switch[BENCHMARK_DVFS_SWITCH_NUMBER];
+}benchmarkDvfs_t;
+
+#define BENCHMARK_WHEEL_TIMERS         10000UL
+
+typedef struct
+{
+  uint32 Timers;           /* active timers */
+  uint32 StartAvgCycles;
+  uint32 StartMaxCycles;
+  uint32 StopAvgCycles;
+  uint32 StopMaxCycles;
+  uint32 ExpireAvgCycles;  /* wheel processing per expired timer (empty ticks and cascades included) */
+  uint32 TickMaxCycles;    /* worst tick */
+  uint32 Ticks;            /* ticks until the last expiry */
+  uint32 Expired;
+}benchmarkTimerWheel_t;
+
+#define BENCHMARK_DELAY_FREQ_NUMBER    3U
+#define BENCHMARK_DELAY_NS_NUMBER      3U
+#define BENCHMARK_DELAY_CYCLES         1000UL
+
+typedef struct
+{
+  uint32 FreqHz;
+  uint32 OverheadCycles;                           /* measured DELAY_OVERHEAD_CYCLES */
+  sint32 CyclesError;                              /* Delay_Cycles(BENCHMARK_DELAY_CYCLES), in cycles */
+  sint32 NsErrorCycles[BENCHMARK_DELAY_NS_NUMBER]; /* Delay_Ns(100, 1000, 10000), in cycles */
+  sint32 UsErrorUs;                                /* Delay_Us(10000) measured on TIMER0 */
+}benchmarkDelayFreq_t;
+
+typedef struct
+{
+  uint32               Failures;                   /* rejected frequency changes */
+  benchmarkDelayFreq_t Freq[BENCHMARK_DELAY_FREQ_NUMBER];
+}benchmarkDelay_t;
+
+#define BENCHMARK_CORE_TIMER_PERIODS   100UL
+
+typedef struct
+{
+  uint32 PeriodUs;
+  uint32 Periods;
+  uint32 MinCycles;        /* interval between two callbacks */
+  uint32 MaxCycles;
+  uint32 AvgCycles;
+  uint32 Jitter;           /* MaxCycles - MinCycles */
+  uint32 OneShotCalls;     /* 1 expected */
+}benchmarkCoreTimer_t;
+
+#define BENCHMARK_RING_MESSAGES        20000UL
+#define BENCHMARK_RING_WORDS           8UL      /* 32-byte sample block per message */
+#define BENCHMARK_RING_BURST           8UL
+#define BENCHMARK_RING_MODES           2U       /* single message, burst */
+
+typedef struct
+{
+  uint32 Burst;            /* messages per push / pop */
+  uint32 DurationUs;       /* first push to the last message received */
+  uint32 MsgPerSec;
+  uint32 BytesPerSec;
+  uint32 Errors;           /* messages received out of sequence */
+  uint32 Wakeups;          /* consumer doorbells */
+}benchmarkRingMode_t;
+
+typedef struct
+{
+  uint32              Messages;
+  uint32              MessageBytes;
+  benchmarkRingMode_t Mode[BENCHMARK_RING_MODES];
+}benchmarkRing_t;
+
+#define BENCHMARK_RPC_CALLS            1000UL
+#define BENCHMARK_RPC_POSTS            1000UL
+
+typedef struct
+{
+  uint32 Calls;            /* synchronous calls core 0 -> core 1 */
+  uint32 MinCycles;        /* round-trip, cycles of core 0 */
+  uint32 MaxCycles;
+  uint32 AvgCycles;
+  uint32 Errors;           /* wrong results */
+  uint32 Posts;            /* fire-and-forget calls */
+  uint32 PostAvgCycles;    /* queueing cost on core 0 */
+  uint32 QueueFull;        /* posts retried (queue of core 1 full) */
+  uint32 PostsServed;      /* posts executed by core 1 */
+}benchmarkRpc_t;
+
+#define BENCHMARK_LOCK_ITERATIONS      10000UL
+#define BENCHMARK_LOCK_KINDS           4U       /* SIO spinlock, exclusive access, ticket, MCS */
+
+typedef struct
+{
+  uint32 Kind;               /* 0: SIO spinlock, 1: exclusive access, 2: ticket lock, 3: MCS lock */
+  uint32 UncontendedCycles;  /* lock + unlock, core 0 alone */
+  uint32 ContendedCycles;    /* per lock + unlock, both cores: DurationCycles / (2 * Iterations) */
+  uint32 DurationCycles;     /* both cores, cycles of core 0 */
+  uint32 Errors;             /* lost increments of the shared counter */
+  uint32 Spins;              /* ticket and MCS locks: multicoreLockStats_t, both phases */
+  uint32 MaxWaitCycles;
+}benchmarkLockKind_t;
+
+typedef struct
+{
+  uint32              Iterations;       /* per core */
+  benchmarkLockKind_t Kind[BENCHMARK_LOCK_KINDS];
+}benchmarkLock_t;
+
+#define BENCHMARK_BARRIER_EPISODES     1000UL
+#define BENCHMARK_BARRIER_TIMEOUT      10000UL  /* cycles, core 1 absent */
+
+typedef struct
+{
+  uint32 Episodes;         /* barriers passed by both cores */
+  uint32 AvgCycles;        /* per barrier, cycles of core 0 */
+  uint32 LastSkewCycles;   /* wait of the first arriving core */
+  uint32 MaxSkewCycles;
+  uint32 TimeoutPassed;    /* 0 expected: the lone core 0 must time out */
+  uint32 Timeouts;         /* 1 expected */
+}benchmarkBarrier_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+extern volatile uint32                Benchmark_SysClockKhz;
+extern volatile benchmarkLoopJitter_t Benchmark_LoopJitterResult;
+extern volatile benchmarkDvfs_t       Benchmark_DvfsResult;
+extern volatile benchmarkTimerWheel_t Benchmark_TimerWheelResult;
+extern volatile benchmarkDelay_t      Benchmark_DelayResult;
+extern volatile benchmarkCoreTimer_t  Benchmark_CoreTimerResult;
+extern volatile benchmarkRing_t       Benchmark_RingResult;
+extern volatile benchmarkRpc_t        Benchmark_RpcResult;
+extern volatile benchmarkLock_t       Benchmark_LockResult;
+extern volatile benchmarkBarrier_t    Benchmark_BarrierResult;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void Benchmark_RunCore0(void);
+void Benchmark_RunCore1(void);
+void Benchmark_LoopJitter(void);
+void Benchmark_DvfsSwitch(void);
+void Benchmark_TimerWheel(void);
+void Benchmark_Delay(void);
+void Benchmark_CoreTimer(void);
+void Benchmark_RingProducer(void);
+void Benchmark_RingConsumer(void);
+void Benchmark_Rpc(void);
+void Benchmark_Lock(void);
+void Benchmark_LockCore1(void);
+void Benchmark_Barrier(void);
+void Benchmark_BarrierCore1(void);
+
+#endif /*__BENCHMARK_H__*/
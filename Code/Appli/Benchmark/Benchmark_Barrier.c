@@ -0,0 +1,75 @@
+/******************************************************************************************
+  Filename    : Benchmark_Barrier.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Multicore barrier benchmark (lock-step phases and timeout)
+  
+                Both cores pass the same barrier BENCHMARK_BARRIER_EPISODES times in a
+                row, then core 0 waits alone with a timeout: the wait must fail and
+                leave the barrier usable.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "MulticoreBarrier.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkBarrier_t Benchmark_BarrierResult;
+
+static multicoreBarrier_t Benchmark_BarrierObject = MULTICORE_BARRIER_INIT(2UL);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_Barrier function (core 0)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_Barrier(void)
+{
+  const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+  for(uint32 episode = 0UL; episode < BENCHMARK_BARRIER_EPISODES; episode++)
+  {
+    (void)MulticoreBarrier_Wait(&Benchmark_BarrierObject, MULTICORE_BARRIER_NO_TIMEOUT);
+  }
+
+  Benchmark_BarrierResult.AvgCycles      = (CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles) / BENCHMARK_BARRIER_EPISODES;
+  Benchmark_BarrierResult.Episodes       = Benchmark_BarrierObject.Episodes;
+  Benchmark_BarrierResult.LastSkewCycles = Benchmark_BarrierObject.LastSkewCycles;
+  Benchmark_BarrierResult.MaxSkewCycles  = Benchmark_BarrierObject.MaxSkewCycles;
+
+  /* core 1 left the barrier loop */
+  Benchmark_BarrierResult.TimeoutPassed = (uint32)MulticoreBarrier_Wait(&Benchmark_BarrierObject, BENCHMARK_BARRIER_TIMEOUT);
+  Benchmark_BarrierResult.Timeouts      = Benchmark_BarrierObject.Timeouts;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_BarrierCore1 function (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_BarrierCore1(void)
+{
+  for(uint32 episode = 0UL; episode < BENCHMARK_BARRIER_EPISODES; episode++)
+  {
+    (void)MulticoreBarrier_Wait(&Benchmark_BarrierObject, MULTICORE_BARRIER_NO_TIMEOUT);
+  }
+}
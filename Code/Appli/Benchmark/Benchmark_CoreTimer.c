@@ -0,0 +1,139 @@
+/******************************************************************************************
+  Filename    : Benchmark_CoreTimer.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Core timer benchmark (periodic task jitter and one-shot behavior)
+  
+                The same periodic task runs on the SysTick (ARM build) and on the
+                machine timer (RISC-V build): the results of both builds compare the
+                architectures. The interval between two callbacks is measured with the
+                cycle counter, the idle time is spent in WFI.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "CoreTimer.h"
+#include "Delay.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_CORE_TIMER_PERIOD_US    1000UL
+#define BENCHMARK_CORE_TIMER_ONE_SHOT_US  500UL
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Benchmark_CoreTimerPeriodic(void);
+static void Benchmark_CoreTimerOneShot(void);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkCoreTimer_t Benchmark_CoreTimerResult;
+
+static volatile uint32 Benchmark_CoreTimerLastCycles;
+static volatile uint32 Benchmark_CoreTimerSumCycles;
+static volatile uint32 Benchmark_CoreTimerCalls;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_CoreTimer function
+///
+/// \descr  The interrupts of core 0 are enabled during the benchmark only
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_CoreTimer(void)
+{
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+
+  Benchmark_CoreTimerResult.PeriodUs     = BENCHMARK_CORE_TIMER_PERIOD_US;
+  Benchmark_CoreTimerResult.Periods      = BENCHMARK_CORE_TIMER_PERIODS;
+  Benchmark_CoreTimerResult.MinCycles    = (uint32)-1;
+  Benchmark_CoreTimerResult.MaxCycles    = 0UL;
+  Benchmark_CoreTimerResult.OneShotCalls = 0UL;
+
+  Benchmark_CoreTimerSumCycles = 0UL;
+  Benchmark_CoreTimerCalls     = 0UL;
+
+  CORE_ARCH_ENABLE_INTERRUPTS();
+
+  /* periodic: the first callback is the time reference, the task stops itself */
+  (void)CoreTimer_Start(BENCHMARK_CORE_TIMER_PERIOD_US, CORE_TIMER_PERIODIC, &Benchmark_CoreTimerPeriodic);
+
+  while(TRUE == CoreTimer_IsRunning())
+  {
+    CORE_ARCH_WAIT_FOR_INTERRUPT();
+  }
+
+  Benchmark_CoreTimerResult.AvgCycles = Benchmark_CoreTimerSumCycles / BENCHMARK_CORE_TIMER_PERIODS;
+  Benchmark_CoreTimerResult.Jitter    = Benchmark_CoreTimerResult.MaxCycles - Benchmark_CoreTimerResult.MinCycles;
+
+  /* one-shot: a single callback, nothing after it */
+  (void)CoreTimer_Start(BENCHMARK_CORE_TIMER_ONE_SHOT_US, CORE_TIMER_ONE_SHOT, &Benchmark_CoreTimerOneShot);
+
+  while(TRUE == CoreTimer_IsRunning())
+  {
+    CORE_ARCH_WAIT_FOR_INTERRUPT();
+  }
+
+  Delay_Us(4UL * BENCHMARK_CORE_TIMER_ONE_SHOT_US);
+
+  CORE_ARCH_DISABLE_INTERRUPTS();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_CoreTimerPeriodic function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_CoreTimerPeriodic(void)
+{
+  const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+  if(Benchmark_CoreTimerCalls != 0UL)
+  {
+    const uint32 Interval = Cycles - Benchmark_CoreTimerLastCycles;
+
+    if(Interval < Benchmark_CoreTimerResult.MinCycles) { Benchmark_CoreTimerResult.MinCycles = Interval; }
+    if(Interval > Benchmark_CoreTimerResult.MaxCycles) { Benchmark_CoreTimerResult.MaxCycles = Interval; }
+
+    Benchmark_CoreTimerSumCycles += Interval;
+  }
+
+  Benchmark_CoreTimerLastCycles = Cycles;
+
+  if(++Benchmark_CoreTimerCalls > BENCHMARK_CORE_TIMER_PERIODS)
+  {
+    CoreTimer_Stop();
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_CoreTimerOneShot function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_CoreTimerOneShot(void)
+{
+  Benchmark_CoreTimerResult.OneShotCalls++;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************************
+  Filename    : Benchmark_Delay.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Delay self-test (error of Delay_Cycles/Delay_Ns/Delay_Us at several clk_sys)
+  
+                The cycle delays are measured with the cycle counter (the cost of the
+                measurement itself is removed), Delay_Us is measured on TIMER0 which
+                does not depend on clk_sys. A positive error is a longer delay.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "ClockDvfs.h"
+#include "Clock_Cfg.h"
+#include "Delay.h"
+#include "Timebase.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_DELAY_LOW_HZ      48000000UL
+#define BENCHMARK_DELAY_BOOST_HZ    200000000UL
+#define BENCHMARK_DELAY_US          10000UL
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkDelay_t Benchmark_DelayResult;
+
+static const uint32 Benchmark_DelayFreq[BENCHMARK_DELAY_FREQ_NUMBER] =
+{
+  BENCHMARK_DELAY_LOW_HZ,
+  CLOCK_SYS_FREQ_HZ,
+  BENCHMARK_DELAY_BOOST_HZ
+};
+
+static const uint32 Benchmark_DelayNs[BENCHMARK_DELAY_NS_NUMBER] = { 100UL, 1000UL, 10000UL };
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_Delay function
+///
+/// \descr  The boot clk_sys is restored at the end
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_Delay(void)
+{
+  const uint32 BootFreqHz = RP2350_ClockDvfsGetSysFreq();
+
+  Benchmark_DelayResult.Failures = 0UL;
+
+  for(uint32 idx = 0UL; idx < BENCHMARK_DELAY_FREQ_NUMBER; idx++)
+  {
+    volatile benchmarkDelayFreq_t* pResult = &Benchmark_DelayResult.Freq[idx];
+
+    if(FALSE == RP2350_ClockDvfsSetSysFreq(Benchmark_DelayFreq[idx]))
+    {
+      Benchmark_DelayResult.Failures++;
+    }
+
+    pResult->FreqHz = RP2350_ClockDvfsGetSysFreq();
+
+    /* cost of the measurement: two back-to-back counter reads */
+    uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+    const uint32 BaselineCycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    /* cycles */
+    StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    Delay_Cycles(BENCHMARK_DELAY_CYCLES);
+
+    uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles - BaselineCycles;
+
+    pResult->CyclesError    = (sint32)(Cycles - BENCHMARK_DELAY_CYCLES);
+    pResult->OverheadCycles = (uint32)(pResult->CyclesError + (sint32)DELAY_OVERHEAD_CYCLES);
+
+    /* ns: compared to the exact ns * clk_sys / 10^9 */
+    for(uint32 ns = 0UL; ns < BENCHMARK_DELAY_NS_NUMBER; ns++)
+    {
+      const uint32 ExpectedCycles = RP2350_ClockScale(Benchmark_DelayNs[ns], pResult->FreqHz / 1000UL, 1000000UL);
+
+      StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+      Delay_Ns(Benchmark_DelayNs[ns]);
+
+      Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles - BaselineCycles;
+
+      pResult->NsErrorCycles[ns] = (sint32)(Cycles - ExpectedCycles);
+    }
+
+    /* us: measured on the 1 MHz timebase */
+    const uint32 StartUs = Timebase_GetUs32();
+
+    Delay_Us(BENCHMARK_DELAY_US);
+
+    pResult->UsErrorUs = (sint32)(Timebase_GetUs32() - StartUs - BENCHMARK_DELAY_US);
+  }
+
+  if(FALSE == RP2350_ClockDvfsSetSysFreq(BootFreqHz))
+  {
+    Benchmark_DelayResult.Failures++;
+  }
+}
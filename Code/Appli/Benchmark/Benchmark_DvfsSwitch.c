@@ -0,0 +1,124 @@
+/******************************************************************************************
+  Filename    : Benchmark_DvfsSwitch.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : clk_sys switch latency benchmark (RP2350_ClockDvfsSetSysFreq)
+  
+                Each transition is timed with the TIMER0 raw counter (1 us tick from
+                clk_ref) which is not affected by the clk_sys changes. The boost
+                transitions include the core voltage change and its settling time.
+                clk_sys is back at its boot frequency at the end of the benchmark.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "ClockDvfs.h"
+#include "Clock_Cfg.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_DVFS_REPETITIONS   8UL
+#define BENCHMARK_DVFS_LOW_HZ        48000000UL
+#define BENCHMARK_DVFS_BOOST_HZ      200000000UL
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Benchmark_DvfsNotifier(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkDvfs_t Benchmark_DvfsResult;
+
+static const uint32 Benchmark_DvfsSequence[BENCHMARK_DVFS_SWITCH_NUMBER + 1U] =
+{
+  CLOCK_SYS_FREQ_HZ,
+  BENCHMARK_DVFS_LOW_HZ,
+  CLOCK_SYS_FREQ_HZ,
+  BENCHMARK_DVFS_BOOST_HZ,
+  CLOCK_SYS_FREQ_HZ
+};
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_DvfsSwitch function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_DvfsSwitch(void)
+{
+  (void)RP2350_ClockDvfsRegisterNotifier(&Benchmark_DvfsNotifier);
+
+  Benchmark_DvfsResult.Failures      = 0UL;
+  Benchmark_DvfsResult.NotifierCalls = 0UL;
+  Benchmark_DvfsResult.Repetitions   = BENCHMARK_DVFS_REPETITIONS;
+
+  for(uint32 idx = 0UL; idx < BENCHMARK_DVFS_SWITCH_NUMBER; idx++)
+  {
+    Benchmark_DvfsResult.Switch[idx].FromHz = Benchmark_DvfsSequence[idx];
+    Benchmark_DvfsResult.Switch[idx].ToHz   = Benchmark_DvfsSequence[idx + 1UL];
+    Benchmark_DvfsResult.Switch[idx].MinUs  = (uint32)-1;
+    Benchmark_DvfsResult.Switch[idx].MaxUs  = 0UL;
+    Benchmark_DvfsResult.Switch[idx].AvgUs  = 0UL;
+  }
+
+  for(uint32 repetition = 0UL; repetition < BENCHMARK_DVFS_REPETITIONS; repetition++)
+  {
+    for(uint32 idx = 0UL; idx < BENCHMARK_DVFS_SWITCH_NUMBER; idx++)
+    {
+      const uint32 StartUs = HW_PER_TIMER0->TIMERAWL.reg;
+
+      if(FALSE == RP2350_ClockDvfsSetSysFreq(Benchmark_DvfsSequence[idx + 1UL]))
+      {
+        Benchmark_DvfsResult.Failures++;
+      }
+
+      const uint32 DurationUs = HW_PER_TIMER0->TIMERAWL.reg - StartUs;
+
+      if(DurationUs < Benchmark_DvfsResult.Switch[idx].MinUs) { Benchmark_DvfsResult.Switch[idx].MinUs = DurationUs; }
+      if(DurationUs > Benchmark_DvfsResult.Switch[idx].MaxUs) { Benchmark_DvfsResult.Switch[idx].MaxUs = DurationUs; }
+
+      /* the sum is kept in AvgUs until the end */
+      Benchmark_DvfsResult.Switch[idx].AvgUs += DurationUs;
+    }
+  }
+
+  for(uint32 idx = 0UL; idx < BENCHMARK_DVFS_SWITCH_NUMBER; idx++)
+  {
+    Benchmark_DvfsResult.Switch[idx].AvgUs /= BENCHMARK_DVFS_REPETITIONS;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_DvfsNotifier function
+///
+/// \param  Event     : the DVFS event
+///         OldFreqHz : clk_sys before the change
+///         NewFreqHz : clk_sys after the change
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_DvfsNotifier(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz)
+{
+  (void)Event;
+  (void)OldFreqHz;
+  (void)NewFreqHz;
+
+  Benchmark_DvfsResult.NotifierCalls++;
+}
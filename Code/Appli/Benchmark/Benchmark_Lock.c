@@ -0,0 +1,217 @@
+/******************************************************************************************
+  Filename    : Benchmark_Lock.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core lock benchmark (SIO spinlock, exclusive access, ticket, MCS)
+  
+                Per lock kind: the lock + unlock cost on core 0 alone, then both cores
+                increment a shared counter under the lock (full contention). A lost
+                increment is a mutual exclusion error. The maximum wait of the fair
+                locks shows the starvation bound of a core.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "MulticoreFairLock.h"
+#include "MulticoreLock.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_LOCK_SIO         0UL
+#define BENCHMARK_LOCK_EXCLUSIVE   1UL
+#define BENCHMARK_LOCK_TICKET      2UL
+#define BENCHMARK_LOCK_MCS         3UL
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Benchmark_LockAcquire(uint32 Kind);
+static void Benchmark_LockRelease(uint32 Kind);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkLock_t Benchmark_LockResult;
+
+static multicoreLock_t       Benchmark_LockObject;
+static multicoreTicketLock_t Benchmark_LockTicket;
+static multicoreMcsLock_t    Benchmark_LockMcs;
+static multicoreLockStats_t  Benchmark_LockStats;
+
+/* protected by the lock under test */
+static volatile uint32 Benchmark_LockCounter;
+
+/* kinds started by core 0 / completed by core 1 */
+static volatile uint32 Benchmark_LockStart;
+static volatile uint32 Benchmark_LockCore1Done;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_Lock function (core 0)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_Lock(void)
+{
+  Benchmark_LockResult.Iterations = BENCHMARK_LOCK_ITERATIONS;
+
+  for(uint32 kind = 0UL; kind < BENCHMARK_LOCK_KINDS; kind++)
+  {
+    volatile benchmarkLockKind_t* pResult = &Benchmark_LockResult.Kind[kind];
+
+    Benchmark_LockStats.Acquisitions  = 0UL;
+    Benchmark_LockStats.Spins         = 0UL;
+    Benchmark_LockStats.MaxWaitCycles = 0UL;
+
+    (void)MulticoreLock_Init(&Benchmark_LockObject, (kind == BENCHMARK_LOCK_SIO) ? MULTICORE_LOCK_BACKEND_SIO : MULTICORE_LOCK_BACKEND_EXCLUSIVE);
+    MulticoreTicketLock_Init(&Benchmark_LockTicket, &Benchmark_LockStats);
+    MulticoreMcsLock_Init(&Benchmark_LockMcs, &Benchmark_LockStats);
+
+    /* uncontended: core 1 waits for the start */
+    uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    for(uint32 idx = 0UL; idx < BENCHMARK_LOCK_ITERATIONS; idx++)
+    {
+      Benchmark_LockAcquire(kind);
+      Benchmark_LockRelease(kind);
+    }
+
+    pResult->Kind              = kind;
+    pResult->UncontendedCycles = (CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles) / BENCHMARK_LOCK_ITERATIONS;
+
+    /* contended: both cores */
+    Benchmark_LockCounter = 0UL;
+
+    CORE_ARCH_RELEASE_BARRIER();
+
+    Benchmark_LockStart = kind + 1UL;
+
+    CORE_ARCH_SEND_EVENT();
+
+    StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    for(uint32 idx = 0UL; idx < BENCHMARK_LOCK_ITERATIONS; idx++)
+    {
+      Benchmark_LockAcquire(kind);
+
+      Benchmark_LockCounter++;
+
+      Benchmark_LockRelease(kind);
+    }
+
+    while(Benchmark_LockCore1Done <= kind)
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+
+    pResult->DurationCycles  = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+    pResult->ContendedCycles = pResult->DurationCycles / (2UL * BENCHMARK_LOCK_ITERATIONS);
+    pResult->Errors          = (2UL * BENCHMARK_LOCK_ITERATIONS) - Benchmark_LockCounter;
+    pResult->Spins           = Benchmark_LockStats.Spins;
+    pResult->MaxWaitCycles   = Benchmark_LockStats.MaxWaitCycles;
+
+    MulticoreLock_Deinit(&Benchmark_LockObject);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_LockCore1 function (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_LockCore1(void)
+{
+  for(uint32 kind = 0UL; kind < BENCHMARK_LOCK_KINDS; kind++)
+  {
+    while(Benchmark_LockStart <= kind)
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+
+    for(uint32 idx = 0UL; idx < BENCHMARK_LOCK_ITERATIONS; idx++)
+    {
+      Benchmark_LockAcquire(kind);
+
+      Benchmark_LockCounter++;
+
+      Benchmark_LockRelease(kind);
+    }
+
+    CORE_ARCH_RELEASE_BARRIER();
+
+    Benchmark_LockCore1Done = kind + 1UL;
+
+    CORE_ARCH_SEND_EVENT();
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_LockAcquire function
+///
+/// \param  Kind : lock under test
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_LockAcquire(uint32 Kind)
+{
+  switch(Kind)
+  {
+    case BENCHMARK_LOCK_TICKET:
+      MulticoreTicketLock_Lock(&Benchmark_LockTicket);
+      break;
+
+    case BENCHMARK_LOCK_MCS:
+      MulticoreMcsLock_Lock(&Benchmark_LockMcs);
+      break;
+
+    default:
+      MulticoreLock_Lock(&Benchmark_LockObject);
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_LockRelease function
+///
+/// \param  Kind : lock under test
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_LockRelease(uint32 Kind)
+{
+  switch(Kind)
+  {
+    case BENCHMARK_LOCK_TICKET:
+      MulticoreTicketLock_Unlock(&Benchmark_LockTicket);
+      break;
+
+    case BENCHMARK_LOCK_MCS:
+      MulticoreMcsLock_Unlock(&Benchmark_LockMcs);
+      break;
+
+    default:
+      MulticoreLock_Unlock(&Benchmark_LockObject);
+      break;
+  }
+}
@@ -0,0 +1,155 @@
+/******************************************************************************************
+  Filename    : Benchmark_LoopJitter.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Control loop jitter benchmark (xip versus copy_to_ram image mode)
+  
+                Each iteration runs a small control loop (FIR filter + PI controller)
+                and measures it with the cycle counter. Between two iterations the
+                XIP cache is thrashed by reading a flash area larger than the cache,
+                like a concurrent flash traffic would do. In the xip image mode the
+                loop code and coefficients are fetched again from the flash, in the
+                copy_to_ram image mode they are not affected.
+  
+                Build and run both variants then compare Benchmark_LoopJitterResult:
+                  make ... BENCHMARK=1 IMAGE_MODE=xip
+                  make ... BENCHMARK=1 IMAGE_MODE=copy_to_ram
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_JITTER_ITERATIONS     1000UL
+#define BENCHMARK_JITTER_FIR_TAPS       16UL
+#define BENCHMARK_JITTER_XIP_BASE       0x10000000UL   /* XIP cached window */
+#define BENCHMARK_JITTER_XIP_SPAN       (32UL * 1024UL) /* twice the XIP cache size */
+#define BENCHMARK_JITTER_XIP_LINE       8UL
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static sint32 Benchmark_ControlLoop(sint32 Input);
+static void   Benchmark_ThrashXipCache(void);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkLoopJitter_t Benchmark_LoopJitterResult;
+
+static const sint32 Benchmark_FirCoefficients[BENCHMARK_JITTER_FIR_TAPS] =
+{
+  -12, -31, 18, 97, 201, 318, 412, 458, 458, 412, 318, 201, 97, 18, -31, -12
+};
+
+static sint32 Benchmark_FirState[BENCHMARK_JITTER_FIR_TAPS];
+static sint32 Benchmark_Integrator;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_LoopJitter function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_LoopJitter(void)
+{
+  uint32 MinCycles = (uint32)-1;
+  uint32 MaxCycles = 0UL;
+  uint32 SumCycles = 0UL;
+  sint32 Output    = 0;
+
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+
+  for(uint32 iteration = 0UL; iteration < BENCHMARK_JITTER_ITERATIONS; iteration++)
+  {
+    Benchmark_ThrashXipCache();
+
+    const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    Output = Benchmark_ControlLoop((sint32)(iteration & 0xFFUL) - Output / 1024);
+
+    const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    MinCycles  = (Cycles < MinCycles) ? Cycles : MinCycles;
+    MaxCycles  = (Cycles > MaxCycles) ? Cycles : MaxCycles;
+    SumCycles += Cycles;
+  }
+
+#ifdef IMAGE_MODE_COPY_TO_RAM
+  Benchmark_LoopJitterResult.CopyToRam  = 1UL;
+#else
+  Benchmark_LoopJitterResult.CopyToRam  = 0UL;
+#endif
+  Benchmark_LoopJitterResult.Iterations = BENCHMARK_JITTER_ITERATIONS;
+  Benchmark_LoopJitterResult.MinCycles  = MinCycles;
+  Benchmark_LoopJitterResult.MaxCycles  = MaxCycles;
+  Benchmark_LoopJitterResult.AvgCycles  = SumCycles / BENCHMARK_JITTER_ITERATIONS;
+  Benchmark_LoopJitterResult.Jitter     = MaxCycles - MinCycles;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_ControlLoop function
+///
+/// \descr  One step of the control loop: FIR filter on the input then a PI controller
+///
+/// \param  Input : the new input sample
+///
+/// \return the controller output
+//-----------------------------------------------------------------------------------------
+static sint32 Benchmark_ControlLoop(sint32 Input)
+{
+  sint32 Filtered = 0;
+
+  for(uint32 tap = BENCHMARK_JITTER_FIR_TAPS - 1UL; tap > 0UL; tap--)
+  {
+    Benchmark_FirState[tap] = Benchmark_FirState[tap - 1UL];
+  }
+
+  Benchmark_FirState[0] = Input;
+
+  for(uint32 tap = 0UL; tap < BENCHMARK_JITTER_FIR_TAPS; tap++)
+  {
+    Filtered += Benchmark_FirState[tap] * Benchmark_FirCoefficients[tap];
+  }
+
+  Filtered /= 4096;
+
+  const sint32 Error = 128 - Filtered;
+
+  Benchmark_Integrator += Error;
+
+  return((Error * 40) + (Benchmark_Integrator / 8));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_ThrashXipCache function
+///
+/// \descr  Read one word per cache line over a flash area larger than the XIP cache
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_ThrashXipCache(void)
+{
+  for(uint32 offset = 0UL; offset < BENCHMARK_JITTER_XIP_SPAN; offset += BENCHMARK_JITTER_XIP_LINE)
+  {
+    (void)*(volatile uint32*)(BENCHMARK_JITTER_XIP_BASE + offset);
+  }
+}
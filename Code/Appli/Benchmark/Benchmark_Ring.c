@@ -0,0 +1,148 @@
+/******************************************************************************************
+  Filename    : Benchmark_Ring.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core ring throughput benchmark (messages and bytes per second)
+  
+                Core 0 produces numbered 32-byte sample blocks, core 1 consumes them and
+                checks the sequence. The duration is measured on TIMER0 by core 0, from
+                the first push to the end of consumption reported by core 1. The
+                consumer sleeps on the empty ring (doorbell wake-up).
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "ClockDvfs.h"
+#include "MulticoreBell.h"
+#include "MulticoreRing.h"
+#include "Timebase.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_RING_ELEMENTS     64UL
+#define BENCHMARK_RING_BYTES        (BENCHMARK_RING_WORDS * sizeof(uint32))
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkRing_t Benchmark_RingResult;
+
+static uint32 Benchmark_RingStorage[BENCHMARK_RING_ELEMENTS][BENCHMARK_RING_WORDS];
+
+static multicoreRing_t Benchmark_Ring = MULTICORE_RING_INIT(Benchmark_RingStorage, BENCHMARK_RING_BYTES, BENCHMARK_RING_ELEMENTS, MULTICORE_BELL_RING);
+
+/* modes completed by the consumer */
+static volatile uint32 Benchmark_RingDone;
+
+static const uint32 Benchmark_RingBurst[BENCHMARK_RING_MODES] = { 1UL, BENCHMARK_RING_BURST };
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RingProducer function (core 0)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_RingProducer(void)
+{
+  uint32 Block[BENCHMARK_RING_BURST][BENCHMARK_RING_WORDS];
+
+  Benchmark_RingResult.Messages     = BENCHMARK_RING_MESSAGES;
+  Benchmark_RingResult.MessageBytes = BENCHMARK_RING_BYTES;
+
+  for(uint32 mode = 0UL; mode < BENCHMARK_RING_MODES; mode++)
+  {
+    const uint32 Burst   = Benchmark_RingBurst[mode];
+    const uint32 Wakeups = Benchmark_Ring.Wakeups;
+    const uint32 StartUs = Timebase_GetUs32();
+    uint32 Sent          = 0UL;
+
+    while(Sent < BENCHMARK_RING_MESSAGES)
+    {
+      const uint32 Count = ((BENCHMARK_RING_MESSAGES - Sent) < Burst) ? (BENCHMARK_RING_MESSAGES - Sent) : Burst;
+
+      /* word 0: sequence number, the other words: sample payload */
+      for(uint32 idx = 0UL; idx < Count; idx++)
+      {
+        for(uint32 word = 0UL; word < BENCHMARK_RING_WORDS; word++)
+        {
+          Block[idx][word] = Sent + idx + word;
+        }
+      }
+
+      Sent += MulticoreRing_Push(&Benchmark_Ring, Block, Count);
+    }
+
+    while(Benchmark_RingDone <= mode)
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+
+    const uint32 DurationUs = Timebase_GetUs32() - StartUs;
+
+    Benchmark_RingResult.Mode[mode].Burst       = Burst;
+    Benchmark_RingResult.Mode[mode].DurationUs  = DurationUs;
+    Benchmark_RingResult.Mode[mode].MsgPerSec   = RP2350_ClockScale(BENCHMARK_RING_MESSAGES, 1000000UL, DurationUs);
+    Benchmark_RingResult.Mode[mode].BytesPerSec = RP2350_ClockScale(BENCHMARK_RING_MESSAGES * BENCHMARK_RING_BYTES, 1000000UL, DurationUs);
+    Benchmark_RingResult.Mode[mode].Wakeups     = Benchmark_Ring.Wakeups - Wakeups;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RingConsumer function (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_RingConsumer(void)
+{
+  uint32 Block[BENCHMARK_RING_BURST][BENCHMARK_RING_WORDS];
+
+  for(uint32 mode = 0UL; mode < BENCHMARK_RING_MODES; mode++)
+  {
+    uint32 Received = 0UL;
+    uint32 Errors   = 0UL;
+
+    while(Received < BENCHMARK_RING_MESSAGES)
+    {
+      MulticoreRing_WaitData(&Benchmark_Ring);
+
+      const uint32 Count = MulticoreRing_Pop(&Benchmark_Ring, Block, Benchmark_RingBurst[mode]);
+
+      for(uint32 idx = 0UL; idx < Count; idx++)
+      {
+        if((Block[idx][0] != (Received + idx)) || (Block[idx][BENCHMARK_RING_WORDS - 1UL] != (Received + idx + BENCHMARK_RING_WORDS - 1UL)))
+        {
+          Errors++;
+        }
+      }
+
+      Received += Count;
+    }
+
+    Benchmark_RingResult.Mode[mode].Errors = Errors;
+
+    CORE_ARCH_RELEASE_BARRIER();
+
+    Benchmark_RingDone = mode + 1UL;
+
+    CORE_ARCH_SEND_EVENT();
+  }
+}
@@ -0,0 +1,142 @@
+/******************************************************************************************
+  Filename    : Benchmark_Rpc.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core RPC benchmark (synchronous round-trip and fire-and-forget cost)
+  
+                Core 0 calls a trivial function on core 1: the round-trip covers the
+                queueing, the doorbell interrupt of core 1, the completion doorbell and
+                the wake-up of core 0 from WFI. Read the round-trip in cycles of core 0.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "MulticoreRpc.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static uint32 Benchmark_RpcIncrement(uint32 Arg);
+static uint32 Benchmark_RpcCount(uint32 Arg);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkRpc_t Benchmark_RpcResult;
+
+/* fire-and-forget calls executed by core 1 */
+static volatile uint32 Benchmark_RpcPostsServed;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_Rpc function (core 0)
+///
+/// \descr  The interrupts of core 0 are enabled during the benchmark only
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_Rpc(void)
+{
+  const uint32 Core0Calls = MulticoreRpc_Stats[0].Calls;
+  const uint32 Core0Sum   = MulticoreRpc_Stats[0].SumCycles;
+  const uint32 QueueFull  = MulticoreRpc_Stats[0].QueueFull;
+  uint32 PostCycles       = 0UL;
+  uint32 Errors           = 0UL;
+
+  MulticoreRpc_Stats[0].MinCycles = (uint32)-1;
+  MulticoreRpc_Stats[0].MaxCycles = 0UL;
+
+  Benchmark_RpcPostsServed = 0UL;
+
+  CORE_ARCH_ENABLE_INTERRUPTS();
+
+  /* synchronous: the result checks the argument and the return path */
+  for(uint32 call = 0UL; call < BENCHMARK_RPC_CALLS; call++)
+  {
+    uint32 Result = 0UL;
+
+    if((MulticoreRpc_Call(&Benchmark_RpcIncrement, call, &Result) == FALSE) || (Result != (call + 1UL)))
+    {
+      Errors++;
+    }
+  }
+
+  /* fire-and-forget: retried while the queue of core 1 is full */
+  for(uint32 post = 0UL; post < BENCHMARK_RPC_POSTS; post++)
+  {
+    boolean Posted = FALSE;
+
+    while(Posted == FALSE)
+    {
+      const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+      Posted = MulticoreRpc_Post(&Benchmark_RpcCount, post);
+
+      PostCycles += (Posted == TRUE) ? (CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles) : 0UL;
+    }
+  }
+
+  /* posts have no completion doorbell: Benchmark_RpcCount sends an event */
+  while(Benchmark_RpcPostsServed < BENCHMARK_RPC_POSTS)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
+
+  CORE_ARCH_DISABLE_INTERRUPTS();
+
+  Benchmark_RpcResult.Calls         = MulticoreRpc_Stats[0].Calls - Core0Calls;
+  Benchmark_RpcResult.MinCycles     = MulticoreRpc_Stats[0].MinCycles;
+  Benchmark_RpcResult.MaxCycles     = MulticoreRpc_Stats[0].MaxCycles;
+  Benchmark_RpcResult.AvgCycles     = (MulticoreRpc_Stats[0].SumCycles - Core0Sum) / BENCHMARK_RPC_CALLS;
+  Benchmark_RpcResult.Errors        = Errors;
+  Benchmark_RpcResult.Posts         = BENCHMARK_RPC_POSTS;
+  Benchmark_RpcResult.PostAvgCycles = PostCycles / BENCHMARK_RPC_POSTS;
+  Benchmark_RpcResult.QueueFull     = MulticoreRpc_Stats[0].QueueFull - QueueFull;
+  Benchmark_RpcResult.PostsServed   = Benchmark_RpcPostsServed;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RpcIncrement function (core 1)
+///
+/// \param  Arg : value
+///
+/// \return Arg + 1
+//-----------------------------------------------------------------------------------------
+static uint32 Benchmark_RpcIncrement(uint32 Arg)
+{
+  return(Arg + 1UL);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_RpcCount function (core 1)
+///
+/// \descr  Count the post and wake up core 0 waiting for the last one
+///
+/// \param  Arg : post number (unused)
+///
+/// \return 0
+//-----------------------------------------------------------------------------------------
+static uint32 Benchmark_RpcCount(uint32 Arg)
+{
+  (void)Arg;
+
+  Benchmark_RpcPostsServed++;
+
+  CORE_ARCH_SEND_EVENT();
+
+  return(0UL);
+}
@@ -0,0 +1,148 @@
+/******************************************************************************************
+  Filename    : Benchmark_TimerWheel.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Timing wheel benchmark (start, stop and expiry at 10k active timers)
+  
+                The wheel of core 0 is used without tick: the benchmark advances it
+                with TimerWheel_Process, every tick is measured with the cycle
+                counter. The timeouts are spread over all the wheel levels so the
+                expiry cost includes the cascades.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Benchmark.h"
+#include "TimerWheel.h"
+#include "ClockDvfs.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Macros
+//=============================================================================
+#define BENCHMARK_WHEEL_SPAN_MASK   0x0007FFFFUL   /* timeouts up to 2^19 ticks: 4 levels */
+#define BENCHMARK_WHEEL_LCG(x)      (((x) * 1664525UL) + 1013904223UL)
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Benchmark_WheelExpired(timerWheelTimer_t* pTimer);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile benchmarkTimerWheel_t Benchmark_TimerWheelResult;
+
+static timerWheelTimer_t Benchmark_WheelTimers[BENCHMARK_WHEEL_TIMERS];
+static uint32 Benchmark_WheelExpiredCount;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_TimerWheel function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Benchmark_TimerWheel(void)
+{
+  uint32 Seed      = 0x12345678UL;
+  uint32 MaxCycles = 0UL;
+  uint32 SumCycles = 0UL;
+
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+
+  TimerWheel_Init(TIMER_WHEEL_NO_TICK);
+
+  Benchmark_WheelExpiredCount = 0UL;
+
+  /* start: 10k timers with pseudo-random timeouts */
+  for(uint32 idx = 0UL; idx < BENCHMARK_WHEEL_TIMERS; idx++)
+  {
+    Seed = BENCHMARK_WHEEL_LCG(Seed);
+
+    const uint32 Ticks       = 1UL + ((Seed >> 8) & BENCHMARK_WHEEL_SPAN_MASK);
+    const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    (void)TimerWheel_Start(&Benchmark_WheelTimers[idx], Ticks, 0UL, &Benchmark_WheelExpired, TIMER_WHEEL_CONTEXT_ISR);
+
+    const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    MaxCycles  = (Cycles > MaxCycles) ? Cycles : MaxCycles;
+    SumCycles += Cycles;
+  }
+
+  Benchmark_TimerWheelResult.Timers         = BENCHMARK_WHEEL_TIMERS;
+  Benchmark_TimerWheelResult.StartAvgCycles = SumCycles / BENCHMARK_WHEEL_TIMERS;
+  Benchmark_TimerWheelResult.StartMaxCycles = MaxCycles;
+
+  /* stop: every second timer at 10k active timers, then restart it */
+  MaxCycles = 0UL;
+  SumCycles = 0UL;
+
+  for(uint32 idx = 0UL; idx < BENCHMARK_WHEEL_TIMERS; idx += 2UL)
+  {
+    const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    TimerWheel_Stop(&Benchmark_WheelTimers[idx]);
+
+    const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    MaxCycles  = (Cycles > MaxCycles) ? Cycles : MaxCycles;
+    SumCycles += Cycles;
+
+    Seed = BENCHMARK_WHEEL_LCG(Seed);
+
+    (void)TimerWheel_Start(&Benchmark_WheelTimers[idx], 1UL + ((Seed >> 8) & BENCHMARK_WHEEL_SPAN_MASK), 0UL, &Benchmark_WheelExpired, TIMER_WHEEL_CONTEXT_ISR);
+  }
+
+  Benchmark_TimerWheelResult.StopAvgCycles = SumCycles / (BENCHMARK_WHEEL_TIMERS / 2UL);
+  Benchmark_TimerWheelResult.StopMaxCycles = MaxCycles;
+
+  /* expiry: advance the wheel until all the timers expired (up to 2^19 ticks: 64-bit sum) */
+  const uint32 FirstTick = TimerWheel_GetTicks();
+  uint64 ExpireCycles    = 0ULL;
+
+  MaxCycles = 0UL;
+
+  while(Benchmark_WheelExpiredCount < BENCHMARK_WHEEL_TIMERS)
+  {
+    const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    TimerWheel_Process(1UL);
+
+    const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    MaxCycles     = (Cycles > MaxCycles) ? Cycles : MaxCycles;
+    ExpireCycles += (uint64)Cycles;
+  }
+
+  Benchmark_TimerWheelResult.Ticks           = TimerWheel_GetTicks() - FirstTick;
+  Benchmark_TimerWheelResult.Expired         = Benchmark_WheelExpiredCount;
+  Benchmark_TimerWheelResult.ExpireAvgCycles = RP2350_ClockDivide(ExpireCycles, BENCHMARK_WHEEL_TIMERS);
+  Benchmark_TimerWheelResult.TickMaxCycles   = MaxCycles;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Benchmark_WheelExpired function
+///
+/// \param  pTimer : expired timer
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Benchmark_WheelExpired(timerWheelTimer_t* pTimer)
+{
+  (void)pTimer;
+
+  Benchmark_WheelExpiredCount++;
+}
@@ -19,20 +19,35 @@
 // Includes
 //=============================================================================
 #include "Platform_Types.h"
+#include "Compiler.h"
 #include "Cpu.h"
 #include "Gpio.h"
-#include "SysTickTimer.h"
+#include "CoreTimer.h"
+#include "Clock_Cfg.h"
+#include "BootTrace.h"
+#include "InitLevel.h"
+#include "TimerWheel.h"
+#include "core_arch.h"
+#ifdef BENCHMARK
+  #include "Benchmark.h"
+#endif
 
 //=============================================================================
 // Macros
 //=============================================================================
+/* timebase queues of the timing wheel ticks */
+#define MAIN_CORE0_TIMER_WHEEL_QUEUE   0UL
+#define MAIN_CORE1_TIMER_WHEEL_QUEUE   2UL
+
+/* core 1 alive led */
+#define MAIN_CORE1_LED_PERIOD_US       1000000UL
 
 //=============================================================================
 // Prototypes
 //=============================================================================
 void main_Core0(void);
 void main_Core1(void);
-void BlockingDelay(uint32 delay);
+static void main_Core1LedToggle(void) __time_critical;
 
 //=============================================================================
 // Globals
@@ -55,10 +70,27 @@ int main(void)
   main_Core0();
 
   /* Synchronize with core 1 */
+  BOOT_TRACE_MARK(BOOT_TRACE_SYNC_CORE0_ENTRY);
   RP2350_MulticoreSync((uint32_t)HW_PER_SIO->CPUID.reg);
+  BOOT_TRACE_MARK(BOOT_TRACE_SYNC_CORE0_DONE);
+
+#ifdef BENCHMARK
+  /* Run the benchmarks on core 0 */
+  Benchmark_RunCore0();
+#endif
+
+  /* Start the core 0 timing wheel (software timers) */
+  TimerWheel_Init(MAIN_CORE0_TIMER_WHEEL_QUEUE);
 
-  /* endless loop on the core 0 */
-  for(;;);
+  CORE_ARCH_ENABLE_INTERRUPTS();
+
+  /* idle loop on the core 0: sleep until the next timer deadline */
+  for(;;)
+  {
+    (void)TimerWheel_RunDeferred();
+
+    TimerWheel_Idle();
+  }
 
   /* never reached */
   return(0);
@@ -87,8 +119,11 @@ void main_Core0(void)
 
 
   /* Start the Core 1 and turn on the led to be sure that we passed successfully the core 1 initiaization */
+  BOOT_TRACE_MARK(BOOT_TRACE_START_CORE1_ENTRY);
+
   if(TRUE == RP2350_StartCore1())
   {
+    BOOT_TRACE_MARK(BOOT_TRACE_START_CORE1_DONE);
     LED_GREEN_ON();
   }
   else
@@ -109,11 +144,10 @@ void main_Core0(void)
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
-  volatile uint64_t* pMTIMECMP = (volatile uint64_t*)&(HW_PER_SIO->MTIMECMP.reg);
-  volatile uint64_t* pMTIME    = (volatile uint64_t*)&(HW_PER_SIO->MTIME.reg);
-
 void main_Core1(void)
 {
+  BOOT_TRACE_MARK(BOOT_TRACE_CORE1_ENTRY);
+
 #ifdef DEBUG
   while(boHaltCore1);
 #endif
@@ -126,7 +160,8 @@ void main_Core1(void)
 #ifdef CORE_FAMILY_ARM
 
   /*Setting EXTEXCLALL allows external exclusive operations to be used in a configuration with no MPU.
-  This is because the default memory map does not include any shareable Normal memory.*/
+  This is because the default memory map does not include any shareable Normal memory.
+  Required by arch_spin_lock and the MULTICORE_LOCK_BACKEND_EXCLUSIVE locks (not by the SIO spinlocks).*/
   SCnSCB->ACTLR |= (1ul<<29);
 
   __asm volatile("DSB");
@@ -137,66 +172,45 @@ void main_Core1(void)
 #endif
 
   /* Synchronize with core 0 */
+  BOOT_TRACE_MARK(BOOT_TRACE_SYNC_CORE1_ENTRY);
   RP2350_MulticoreSync((uint32_t)HW_PER_SIO->CPUID.reg);
+  BOOT_TRACE_MARK(BOOT_TRACE_SYNC_CORE1_DONE);
 
+  /* Run the deferred initialization level off the core 0 critical path */
+  InitLevel_Run(INIT_LEVEL_DEFERRED);
 
-#ifdef CORE_FAMILY_RISC_V
-
-  /* configure the machine timer for 1Hz interrupt window */
-  #include "riscv.h"
-
-  /* enable machine timer interrupt */
-  riscv_set_csr(RVCSR_MIE_OFFSET, 0x80ul);
-
-  /* enable global interrupt */
-  riscv_set_csr(RVCSR_MSTATUS_OFFSET, 0x08ul);
-
-  /* configure machine timer to use 150 MHz */
-  HW_PER_SIO->MTIME_CTRL.bit.FULLSPEED = 1;
-
-  /* set next timeout (machine timer is enabled by default) */
-  *pMTIMECMP = *pMTIME + 150000000ul; //1s
+  /* Start the core 1 timing wheel (software timers) */
+  TimerWheel_Init(MAIN_CORE1_TIMER_WHEEL_QUEUE);
 
-#else
+  /* blink the led from the core 1 timer (SysTick or machine timer) */
+  (void)CoreTimer_Start(MAIN_CORE1_LED_PERIOD_US, CORE_TIMER_PERIODIC, &main_Core1LedToggle);
 
-  /* configure ARM systick timer */
-  SysTickTimer_Init();
-  SysTickTimer_Start(SYS_TICK_MS(100));
+  CORE_ARCH_ENABLE_INTERRUPTS();
 
+#ifdef BENCHMARK
+  /* Run the core 1 side of the multicore benchmarks */
+  Benchmark_RunCore1();
 #endif
 
+  /* idle loop on the core 1: sleep until the next timer deadline or interrupt */
   while(1)
   {
-    __asm("nop");
-  }
-}
-
+    (void)TimerWheel_RunDeferred();
 
-#ifdef CORE_FAMILY_RISC_V
-  __attribute__((interrupt)) void Isr_MachineTimerInterrupt(void);
-  
-  void Isr_MachineTimerInterrupt(void)
-  {
-    *pMTIMECMP = *pMTIME + 150000000ul;
-  
-    LED_GREEN_TOGGLE();
+    TimerWheel_Idle();
   }
+}
 
-#else
-
-  void SysTickTimer(void);
-
-  void SysTickTimer(void)
-  {
-    static uint32_t cpt = 0;
-
-    SysTickTimer_Reload(SYS_TICK_MS(100));
-    
-    if(++cpt >= 10ul)
-    {
-      LED_GREEN_TOGGLE();
-      cpt = 0;
-    }
-  }
-#endif
-
+//-----------------------------------------------------------------------------------------
+/// \brief  main_Core1LedToggle function
+///
+/// \descr  Core 1 timer callback
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void main_Core1LedToggle(void)
+{
+  LED_GREEN_TOGGLE();
+}
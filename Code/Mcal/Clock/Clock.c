@@ -19,63 +19,574 @@
 // Includes
 //=============================================================================
 #include "Clock.h"
+#include "Clock_Cfg.h"
+#include "Compiler.h"
+#include "ClockDvfs.h"
+#include "Cpu.h"
 
 
+//=============================================================================
+// Defines
+//=============================================================================
+/* PLL_SYS dividers: see the solver in Clock_Cfg.h */
+#define CLOCK_CLK_SYS_DIV        0x10000ul
+
+/* Bring-up timeouts (us, the tick runs from the ROSC until clk_ref switches to the XOSC) */
+#define CLOCK_INIT_TIMEOUT_XOSC_US       50000UL
+#define CLOCK_INIT_TIMEOUT_SWITCH_US     1000UL
+#define CLOCK_INIT_TIMEOUT_RESET_US      1000UL
+#define CLOCK_INIT_TIMEOUT_PLL_LOCK_US   10000UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef enum
+{
+  CLOCK_INIT_STATE_IDLE = 0,
+  CLOCK_INIT_STATE_XOSC_WAIT,
+  CLOCK_INIT_STATE_REF_WAIT,
+  CLOCK_INIT_STATE_SYS_REF_WAIT,
+  CLOCK_INIT_STATE_PLL_RESET_WAIT,
+  CLOCK_INIT_STATE_PLL_LOCK_WAIT,
+  CLOCK_INIT_STATE_SYS_PLL_WAIT,
+  CLOCK_INIT_STATE_IO_RESET_WAIT,
+  CLOCK_INIT_STATE_DONE,
+  CLOCK_INIT_STATE_ERROR
+}clockInitState_t;
+
+typedef struct
+{
+  clockInitState_t State;
+  clockInitError_t Error;
+  boolean          WarmReset;
+  uint32           StateStart;  /* TIMER0 time of the state entry */
+}clockInitCtx_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+static const clockPllCfg_t stPllSysBootCfg =
+{
+  CLOCK_PLL_SYS_REFDIV,
+  CLOCK_PLL_SYS_FBDIV,
+  CLOCK_PLL_SYS_POSTDIV1,
+  CLOCK_PLL_SYS_POSTDIV2
+};
+
+/* Timeout of each wait state (us), indexed by clockInitState_t */
+static const uint32 u32ClockInitTimeout[CLOCK_INIT_STATE_DONE] =
+{
+  0UL,
+  CLOCK_INIT_TIMEOUT_XOSC_US,
+  CLOCK_INIT_TIMEOUT_SWITCH_US,
+  CLOCK_INIT_TIMEOUT_SWITCH_US,
+  CLOCK_INIT_TIMEOUT_RESET_US,
+  CLOCK_INIT_TIMEOUT_PLL_LOCK_US,
+  CLOCK_INIT_TIMEOUT_SWITCH_US,
+  CLOCK_INIT_TIMEOUT_RESET_US
+};
+
+/* Error reported when a wait state times out, indexed by clockInitState_t */
+static const clockInitError_t ClockInitTimeoutError[CLOCK_INIT_STATE_DONE] =
+{
+  CLOCK_INIT_ERROR_NOT_STARTED,
+  CLOCK_INIT_ERROR_XOSC_STABLE,
+  CLOCK_INIT_ERROR_REF_SELECT,
+  CLOCK_INIT_ERROR_SYS_REF_SELECT,
+  CLOCK_INIT_ERROR_PLL_SYS_RESET,
+  CLOCK_INIT_ERROR_PLL_SYS_LOCK,
+  CLOCK_INIT_ERROR_SYS_PLL_SELECT,
+  CLOCK_INIT_ERROR_IO_BANK0_RESET
+};
+
+/* not initialized by the startup code: the bring-up runs across the RAM initialization */
+static clockInitCtx_t stClockInitCtx __noinit;
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void    RP2350_ClockInitEnter(clockInitState_t State);
+static void    RP2350_ClockInitPllSysStage(void);
+static void    RP2350_ClockInitSysPllStage(void);
+static void    RP2350_ClockInitIoStage(void);
+static void    RP2350_ClockSysRequestRef(void);
+static boolean RP2350_ClockSysIsOnRef(void);
+static void    RP2350_ClockSysRequestPllSys(void);
+static boolean RP2350_ClockSysIsOnAux(void);
+static void    RP2350_ClockPllSysProgram(const clockPllCfg_t* pPllCfg);
+static boolean RP2350_ClockXoscIsRunning(void);
+static boolean RP2350_ClockRefIsOnXosc(void);
+static boolean RP2350_ClockPllSysIsConfigured(void);
+static boolean RP2350_ClockSysIsOnPll(void);
+
 //-----------------------------------------------------------------------------------------
 /// \brief  RP2350_ClockInit function
 ///
+/// \descr  Blocking clock bring-up (see RP2350_ClockInitStart / RP2350_ClockInitStep).
+///
 /// \param  void
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
 void RP2350_ClockInit(void)
 {
-   /* Init the clock XOSC */
-   HW_PER_XOSC->STARTUP.bit.X4      = 0U;
-   HW_PER_XOSC->STARTUP.bit.DELAY   = 47U;
-   HW_PER_XOSC->CTRL.bit.FREQ_RANGE = HW_PER_XOSC->STATUS.bit.FREQ_RANGE;
-   HW_PER_XOSC->CTRL.bit.ENABLE     = XOSC_CTRL_ENABLE_ENABLE;
-   while(HW_PER_XOSC->STATUS.bit.STABLE != 1U);
+  RP2350_ClockInitStart();
+
+  while(FALSE == RP2350_ClockInitStep());
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitStart function
+///
+/// \descr  Start the non-blocking clock bring-up: XOSC, clk_ref, PLL_SYS, clk_sys,
+///         clk_peri and IO_BANK0. Call RP2350_ClockInitStep until it returns TRUE.
+///         On a warm reset (see RP2350_IsWarmReset) the live clock configuration is
+///         verified and each step which is already correct is skipped.
+///         Does not use the .data/.bss sections: can run before the RAM init.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockInitStart(void)
+{
+  stClockInitCtx.WarmReset = RP2350_IsWarmReset();
+  stClockInitCtx.Error     = CLOCK_INIT_ERROR_NONE;
+
+  /* time base of the timeouts (ticks from the ROSC until clk_ref runs from the XOSC) */
+  RP2350_ClockTickStart();
+
+  if((FALSE == stClockInitCtx.WarmReset) || (FALSE == RP2350_ClockXoscIsRunning()))
+  {
+    /* Init the clock XOSC */
+    HW_PER_XOSC->STARTUP.bit.X4      = 0U;
+    HW_PER_XOSC->STARTUP.bit.DELAY   = CLOCK_XOSC_STARTUP_DELAY;
+    HW_PER_XOSC->CTRL.bit.FREQ_RANGE = HW_PER_XOSC->STATUS.bit.FREQ_RANGE;
+    HW_PER_XOSC->CTRL.bit.ENABLE     = XOSC_CTRL_ENABLE_ENABLE;
+  }
+
+  RP2350_ClockInitEnter(CLOCK_INIT_STATE_XOSC_WAIT);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitStep function
+///
+/// \descr  Advance the clock bring-up as far as possible without waiting.
+///
+/// \param  void
+///
+/// \return TRUE once finished (see RP2350_ClockInitError), FALSE while in progress
+//-----------------------------------------------------------------------------------------
+boolean RP2350_ClockInitStep(void)
+{
+  clockInitState_t PreviousState;
 
-   /* Switch the ref clock to use the xosc clock as source */
-   HW_PER_CLOCKS->CLK_REF_CTRL.bit.SRC = CLOCKS_CLK_REF_CTRL_SRC_xosc_clksrc;
-   while(HW_PER_CLOCKS->CLK_REF_SELECTED.reg != (1ul << CLOCKS_CLK_REF_CTRL_SRC_xosc_clksrc));
+  do
+  {
+    PreviousState = stClockInitCtx.State;
 
-   while(HW_PER_CLOCKS->CLK_REF_DIV.bit.INT != 1);
+    switch(stClockInitCtx.State)
+    {
+      case CLOCK_INIT_STATE_XOSC_WAIT:
+        if(HW_PER_XOSC->STATUS.bit.STABLE == 1U)
+        {
+          if((FALSE == stClockInitCtx.WarmReset) || (FALSE == RP2350_ClockRefIsOnXosc()))
+          {
+            /* Switch the ref clock to use the xosc clock as source */
+            HW_PER_CLOCKS->CLK_REF_CTRL.bit.SRC = CLOCKS_CLK_REF_CTRL_SRC_xosc_clksrc;
+            RP2350_ClockInitEnter(CLOCK_INIT_STATE_REF_WAIT);
+          }
+          else
+          {
+            RP2350_ClockInitPllSysStage();
+          }
+        }
+        break;
 
-  /* Release the reset of PLL_SYS */
-   HW_PER_RESETS->RESET.bit.PLL_SYS = 0U;
-   while(HW_PER_RESETS->RESET_DONE.bit.PLL_SYS != 1);
+      case CLOCK_INIT_STATE_REF_WAIT:
+        if(TRUE == RP2350_ClockRefIsOnXosc())
+        {
+          RP2350_ClockInitPllSysStage();
+        }
+        break;
 
-   /* Configure the PLL_SYS */
-   HW_PER_PLL_SYS->CS.bit.REFDIV           = 1U;
-   HW_PER_PLL_SYS->FBDIV_INT.bit.FBDIV_INT = 125U;
-   HW_PER_PLL_SYS->PRIM.bit.POSTDIV1       = 5U;
-   HW_PER_PLL_SYS->PRIM.bit.POSTDIV2       = 2U;
+      case CLOCK_INIT_STATE_SYS_REF_WAIT:
+        if(TRUE == RP2350_ClockSysIsOnRef())
+        {
+#if (CLOCK_SYS_FREQ_HZ > CLOCK_SYS_FREQ_NOMINAL_HZ)
+          /* Raise the core voltage before running above the nominal frequency (blocking) */
+          RP2350_ClockSetCoreVoltage(CLOCK_VREG_MV(CLOCK_SYS_FREQ_HZ));
+#endif
+          /* Reset the PLL_SYS (powers it down if it was running) */
+          HW_PER_RESETS->RESET.bit.PLL_SYS = 1U;
+          HW_PER_RESETS->RESET.bit.PLL_SYS = 0U;
+          RP2350_ClockInitEnter(CLOCK_INIT_STATE_PLL_RESET_WAIT);
+        }
+        break;
 
-   HW_PER_PLL_SYS->PWR.bit.PD        = 0U;
-   HW_PER_PLL_SYS->PWR.bit.VCOPD     = 0U;
-   HW_PER_PLL_SYS->PWR.bit.POSTDIVPD = 0U;
+      case CLOCK_INIT_STATE_PLL_RESET_WAIT:
+        if(HW_PER_RESETS->RESET_DONE.bit.PLL_SYS == 1U)
+        {
+          RP2350_ClockPllSysProgram(&stPllSysBootCfg);
+          RP2350_ClockInitEnter(CLOCK_INIT_STATE_PLL_LOCK_WAIT);
+        }
+        break;
 
-   while(HW_PER_PLL_SYS->CS.bit.LOCK != 1U);
+      case CLOCK_INIT_STATE_PLL_LOCK_WAIT:
+        if(HW_PER_PLL_SYS->CS.bit.LOCK == 1U)
+        {
+          RP2350_ClockInitSysPllStage();
+        }
+        break;
 
-   /* Switch the system clock to use the PLL */
- 
-   if(HW_PER_CLOCKS->CLK_SYS_DIV.reg != 0x10000ul)
-       HW_PER_CLOCKS->CLK_SYS_DIV.reg = 0x10000ul;
- 
-   HW_PER_CLOCKS->CLK_SYS_CTRL.bit.AUXSRC = CLOCKS_CLK_SYS_CTRL_AUXSRC_clksrc_pll_sys;
-   HW_PER_CLOCKS->CLK_SYS_CTRL.bit.SRC    = CLOCKS_CLK_SYS_CTRL_SRC_clksrc_clk_sys_aux;
- 
-   while(HW_PER_CLOCKS->CLK_SYS_SELECTED.bit.CLK_SYS_SELECTED != (1ul << CLOCKS_CLK_SYS_CTRL_SRC_clksrc_clk_sys_aux));
+      case CLOCK_INIT_STATE_SYS_PLL_WAIT:
+        if(TRUE == RP2350_ClockSysIsOnAux())
+        {
+          RP2350_ClockInitIoStage();
+        }
+        break;
+
+      case CLOCK_INIT_STATE_IO_RESET_WAIT:
+        if(HW_PER_RESETS->RESET_DONE.bit.IO_BANK0 == 1U)
+        {
+          /* The clock tree is valid: the next non power-on reset takes the warm path */
+          RP2350_SetWarmResetMarker();
+          RP2350_ClockInitEnter(CLOCK_INIT_STATE_DONE);
+        }
+        break;
+
+      case CLOCK_INIT_STATE_DONE:
+      case CLOCK_INIT_STATE_ERROR:
+        break;
+
+      default:
+        /* RP2350_ClockInitStart was not called */
+        stClockInitCtx.Error = CLOCK_INIT_ERROR_NOT_STARTED;
+        stClockInitCtx.State = CLOCK_INIT_STATE_ERROR;
+        break;
+    }
+
+  } while(PreviousState != stClockInitCtx.State);
+
+  if(stClockInitCtx.State < CLOCK_INIT_STATE_DONE)
+  {
+    if((HW_PER_TIMER0->TIMERAWL.reg - stClockInitCtx.StateStart) > u32ClockInitTimeout[stClockInitCtx.State])
+    {
+      stClockInitCtx.Error = ClockInitTimeoutError[stClockInitCtx.State];
+      stClockInitCtx.State = CLOCK_INIT_STATE_ERROR;
+    }
+  }
+
+  return((stClockInitCtx.State >= CLOCK_INIT_STATE_DONE) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitError function
+///
+/// \param  void
+///
+/// \return the clock bring-up error: clockInitError_t (CLOCK_INIT_ERROR_NONE on success)
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_ClockInitError(void)
+{
+  return((uint32)stClockInitCtx.Error);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockTickStart function
+///
+/// \descr  Start the TIMER0 1 us tick (clk_ref / XOSC MHz) if it is not running yet
+///         with this divider. Single setup of the tick, also used by BootTrace_Init
+///         which runs before the image copy: kept in the flash (__boot_text).
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockTickStart(void)
+{
+  if((HW_PER_RESETS->RESET_DONE.bit.TIMER0 != 1U) || (HW_PER_TICKS->TIMER0_CTRL.bit.ENABLE != 1U) ||
+     (HW_PER_TICKS->TIMER0_CYCLES.bit.TIMER0_CYCLES != CLOCK_XOSC_FREQ_MHZ))
+  {
+    HW_PER_RESETS->RESET.bit.TIMER0 = 0U;
+    while(HW_PER_RESETS->RESET_DONE.bit.TIMER0 != 1U);
+
+    HW_PER_TICKS->TIMER0_CYCLES.bit.TIMER0_CYCLES = CLOCK_XOSC_FREQ_MHZ;
+    HW_PER_TICKS->TIMER0_CTRL.bit.ENABLE          = 1U;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysSelectRef function
+///
+/// \descr  Move clk_sys to clk_ref through the glitchless mux (no-op if already there).
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockSysSelectRef(void)
+{
+  RP2350_ClockSysRequestRef();
+
+  while(FALSE == RP2350_ClockSysIsOnRef());
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysSelectPllSys function
+///
+/// \descr  Move clk_sys to the PLL_SYS through the aux mux then the glitchless mux.
+///         The aux source is only changed while clk_sys runs from clk_ref.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockSysSelectPllSys(void)
+{
+  RP2350_ClockSysRequestPllSys();
+
+  while(FALSE == RP2350_ClockSysIsOnAux());
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockPllSysConfigure function
+///
+/// \descr  Reset, program and lock the PLL_SYS. clk_sys must not run from the PLL_SYS.
+///
+/// \param  pPllCfg : the PLL_SYS dividers
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockPllSysConfigure(const clockPllCfg_t* pPllCfg)
+{
+  /* Reset the PLL_SYS (powers it down if it was running) */
+  HW_PER_RESETS->RESET.bit.PLL_SYS = 1U;
+  HW_PER_RESETS->RESET.bit.PLL_SYS = 0U;
+  while(HW_PER_RESETS->RESET_DONE.bit.PLL_SYS != 1);
+
+  RP2350_ClockPllSysProgram(pPllCfg);
+
+  while(HW_PER_PLL_SYS->CS.bit.LOCK != 1U);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitEnter function
+///
+/// \param  State : the new state of the clock bring-up
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockInitEnter(clockInitState_t State)
+{
+  stClockInitCtx.State      = State;
+  stClockInitCtx.StateStart = HW_PER_TIMER0->TIMERAWL.reg;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitPllSysStage function
+///
+/// \descr  clk_ref runs from the XOSC: (re)configure the PLL_SYS if needed. A warm reset
+///         only keeps the PLL_SYS if clk_sys already runs from it or from clk_ref, the
+///         aux source must not be changed while the glitchless mux selects it.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockInitPllSysStage(void)
+{
+  if(   (FALSE == stClockInitCtx.WarmReset)
+     || (FALSE == RP2350_ClockPllSysIsConfigured())
+     || ((FALSE == RP2350_ClockSysIsOnPll()) && (FALSE == RP2350_ClockSysIsOnRef())))
+  {
+    /* Never reprogram the PLL_SYS while it is clocking the system */
+    RP2350_ClockSysRequestRef();
+    RP2350_ClockInitEnter(CLOCK_INIT_STATE_SYS_REF_WAIT);
+  }
+  else
+  {
+    RP2350_ClockInitSysPllStage();
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitSysPllStage function
+///
+/// \descr  The PLL_SYS is locked: switch clk_sys to it if needed.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockInitSysPllStage(void)
+{
+  if((FALSE == stClockInitCtx.WarmReset) || (FALSE == RP2350_ClockSysIsOnPll()))
+  {
+    /* Switch the system clock to use the PLL */
+    RP2350_ClockSysRequestPllSys();
+    RP2350_ClockInitEnter(CLOCK_INIT_STATE_SYS_PLL_WAIT);
+  }
+  else
+  {
+    RP2350_ClockInitIoStage();
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockInitIoStage function
+///
+/// \descr  clk_sys runs from the PLL_SYS: enable clk_peri and release IO_BANK0.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockInitIoStage(void)
+{
+  /* Enable clock for peripheral */
+  HW_PER_CLOCKS->CLK_PERI_CTRL.bit.ENABLE = 1U;
+
+  /* Release reset on IO_BANK0 */
+  HW_PER_RESETS->RESET.bit.IO_BANK0 = 0U;
 
-   /* Enable clock for peripheral */
-   HW_PER_CLOCKS->CLK_PERI_CTRL.bit.ENABLE = 1U;
+  RP2350_ClockInitEnter(CLOCK_INIT_STATE_IO_RESET_WAIT);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysRequestRef function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockSysRequestRef(void)
+{
+  if(HW_PER_CLOCKS->CLK_SYS_CTRL.bit.SRC != CLOCKS_CLK_SYS_CTRL_SRC_clk_ref)
+  {
+    HW_PER_CLOCKS->CLK_SYS_CTRL.bit.SRC = CLOCKS_CLK_SYS_CTRL_SRC_clk_ref;
+  }
+}
 
-   /* Release reset on IO_BANK0 */
-    HW_PER_RESETS->RESET.bit.IO_BANK0 = 0U;
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysIsOnRef function
+///
+/// \param  void
+///
+/// \return TRUE if the glitchless mux selects clk_ref
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockSysIsOnRef(void)
+{
+  return((HW_PER_CLOCKS->CLK_SYS_SELECTED.bit.CLK_SYS_SELECTED == (1ul << CLOCKS_CLK_SYS_CTRL_SRC_clk_ref)) ? TRUE : FALSE);
+}
 
-    /* Wait for reset to be done */
-    /* Release reset is done on IO_BANK0 */
-    while(HW_PER_RESETS->RESET_DONE.bit.IO_BANK0 != 1);
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysRequestPllSys function
+///
+/// \descr  Select the PLL_SYS on the aux mux then the aux mux on the glitchless mux.
+///         clk_sys must run from clk_ref.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockSysRequestPllSys(void)
+{
+  if(HW_PER_CLOCKS->CLK_SYS_DIV.reg != CLOCK_CLK_SYS_DIV)
+      HW_PER_CLOCKS->CLK_SYS_DIV.reg = CLOCK_CLK_SYS_DIV;
+
+  HW_PER_CLOCKS->CLK_SYS_CTRL.bit.AUXSRC = CLOCKS_CLK_SYS_CTRL_AUXSRC_clksrc_pll_sys;
+  HW_PER_CLOCKS->CLK_SYS_CTRL.bit.SRC    = CLOCKS_CLK_SYS_CTRL_SRC_clksrc_clk_sys_aux;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysIsOnAux function
+///
+/// \param  void
+///
+/// \return TRUE if the glitchless mux selects the aux source
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockSysIsOnAux(void)
+{
+  return((HW_PER_CLOCKS->CLK_SYS_SELECTED.bit.CLK_SYS_SELECTED == (1ul << CLOCKS_CLK_SYS_CTRL_SRC_clksrc_clk_sys_aux)) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockPllSysProgram function
+///
+/// \descr  Program the dividers and power up the PLL_SYS (out of reset), no lock wait.
+///
+/// \param  pPllCfg : the PLL_SYS dividers
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockPllSysProgram(const clockPllCfg_t* pPllCfg)
+{
+  HW_PER_PLL_SYS->CS.bit.REFDIV           = pPllCfg->RefDiv;
+  HW_PER_PLL_SYS->FBDIV_INT.bit.FBDIV_INT = pPllCfg->FbDiv;
+  HW_PER_PLL_SYS->PRIM.bit.POSTDIV1       = pPllCfg->PostDiv1;
+  HW_PER_PLL_SYS->PRIM.bit.POSTDIV2       = pPllCfg->PostDiv2;
+
+  HW_PER_PLL_SYS->PWR.bit.PD        = 0U;
+  HW_PER_PLL_SYS->PWR.bit.VCOPD     = 0U;
+  HW_PER_PLL_SYS->PWR.bit.POSTDIVPD = 0U;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockXoscIsRunning function
+///
+/// \param  void
+///
+/// \return TRUE if the XOSC is enabled and stable
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockXoscIsRunning(void)
+{
+  return(((HW_PER_XOSC->CTRL.bit.ENABLE == XOSC_CTRL_ENABLE_ENABLE) && (HW_PER_XOSC->STATUS.bit.STABLE == 1U)) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockRefIsOnXosc function
+///
+/// \param  void
+///
+/// \return TRUE if clk_ref runs from the XOSC without divider
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockRefIsOnXosc(void)
+{
+  return(((HW_PER_CLOCKS->CLK_REF_SELECTED.reg == (1ul << CLOCKS_CLK_REF_CTRL_SRC_xosc_clksrc)) &&
+          (HW_PER_CLOCKS->CLK_REF_DIV.bit.INT  == 1U)) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockPllSysIsConfigured function
+///
+/// \param  void
+///
+/// \return TRUE if the PLL_SYS is out of reset, powered, locked and has the expected dividers
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockPllSysIsConfigured(void)
+{
+  return(((HW_PER_RESETS->RESET_DONE.bit.PLL_SYS    == 1U)                     &&
+          (HW_PER_PLL_SYS->PWR.bit.PD               == 0U)                     &&
+          (HW_PER_PLL_SYS->PWR.bit.VCOPD            == 0U)                     &&
+          (HW_PER_PLL_SYS->PWR.bit.POSTDIVPD        == 0U)                     &&
+          (HW_PER_PLL_SYS->CS.bit.REFDIV            == CLOCK_PLL_SYS_REFDIV)   &&
+          (HW_PER_PLL_SYS->FBDIV_INT.bit.FBDIV_INT  == CLOCK_PLL_SYS_FBDIV)    &&
+          (HW_PER_PLL_SYS->PRIM.bit.POSTDIV1        == CLOCK_PLL_SYS_POSTDIV1) &&
+          (HW_PER_PLL_SYS->PRIM.bit.POSTDIV2        == CLOCK_PLL_SYS_POSTDIV2) &&
+          (HW_PER_PLL_SYS->CS.bit.LOCK              == 1U)) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSysIsOnPll function
+///
+/// \param  void
+///
+/// \return TRUE if clk_sys runs from the PLL_SYS with the expected divider
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockSysIsOnPll(void)
+{
+  return(((HW_PER_CLOCKS->CLK_SYS_DIV.reg                       == CLOCK_CLK_SYS_DIV)                          &&
+          (HW_PER_CLOCKS->CLK_SYS_CTRL.bit.AUXSRC               == CLOCKS_CLK_SYS_CTRL_AUXSRC_clksrc_pll_sys)  &&
+          (HW_PER_CLOCKS->CLK_SYS_SELECTED.bit.CLK_SYS_SELECTED == (1ul << CLOCKS_CLK_SYS_CTRL_SRC_clksrc_clk_sys_aux))) ? TRUE : FALSE);
 }
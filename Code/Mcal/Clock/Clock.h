@@ -22,13 +22,43 @@
 //=============================================================================
 #include "RP2350.h"
 #include "Platform_Types.h"
+#include "Compiler.h"
 
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  uint32 RefDiv;
+  uint32 FbDiv;
+  uint32 PostDiv1;
+  uint32 PostDiv2;
+}clockPllCfg_t;
 
+typedef enum
+{
+  CLOCK_INIT_ERROR_NONE = 0,
+  CLOCK_INIT_ERROR_NOT_STARTED,
+  CLOCK_INIT_ERROR_XOSC_STABLE,      /* XOSC STATUS.STABLE timeout */
+  CLOCK_INIT_ERROR_REF_SELECT,       /* CLK_REF_SELECTED (xosc) timeout */
+  CLOCK_INIT_ERROR_SYS_REF_SELECT,   /* CLK_SYS_SELECTED (clk_ref) timeout */
+  CLOCK_INIT_ERROR_PLL_SYS_RESET,    /* RESET_DONE.PLL_SYS timeout */
+  CLOCK_INIT_ERROR_PLL_SYS_LOCK,     /* PLL_SYS CS.LOCK timeout */
+  CLOCK_INIT_ERROR_SYS_PLL_SELECT,   /* CLK_SYS_SELECTED (aux) timeout */
+  CLOCK_INIT_ERROR_IO_BANK0_RESET    /* RESET_DONE.IO_BANK0 timeout */
+}clockInitError_t;
 
 //=============================================================================
 // Functions prototype
 //=============================================================================
 void RP2350_ClockInit(void);
+void RP2350_ClockInitStart(void);
+boolean RP2350_ClockInitStep(void);
+uint32 RP2350_ClockInitError(void);
+void RP2350_ClockTickStart(void) __boot_text;
+void RP2350_ClockSysSelectRef(void);
+void RP2350_ClockSysSelectPllSys(void);
+void RP2350_ClockPllSysConfigure(const clockPllCfg_t* pPllCfg);
 
 
 
@@ -0,0 +1,328 @@
+/******************************************************************************************
+  Filename    : ClockDvfs.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Runtime clk_sys scaling (DVFS) for RP2350
+  
+                The PLL_SYS is reprogrammed while clk_sys runs from clk_ref (glitchless
+                mux), then clk_sys goes back to the PLL_SYS through the aux mux.
+                The core voltage is raised before a frequency increase and lowered
+                after a frequency decrease (CLOCK_VREG_MV in Clock_Cfg.h).
+  
+                The registered notifiers are called before and after each change so
+                that the clk_sys derived settings are recomputed. The only one in the
+                tree is the Delay calibration: the SysTick, the machine timer and
+                TIMER0/1 count the XOSC TICKS reference, USB runs from PLL_USB, and
+                clk_peri (clk_sys) has no driver yet (no UART / SPI baud divider).
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "ClockDvfs.h"
+#include "Clock.h"
+#include "Clock_Cfg.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define CLOCK_POWMAN_PASSWORD        0x5AFE0000UL
+#define CLOCK_POWMAN_PASSWORD_MSK    0xFFFF0000UL
+#define CLOCK_VREG_VSEL_POS          4UL
+#define CLOCK_VREG_VSEL_MSK          (0x1FUL << CLOCK_VREG_VSEL_POS)
+#define CLOCK_VREG_VSEL_LINEAR_MAX   15UL    /* 0.55 V + VSEL * 50 mV up to 1.30 V */
+#define CLOCK_VREG_MIN_MV            550UL
+#define CLOCK_VREG_MAX_MV            1300UL
+#define CLOCK_VREG_STEP_MV           50UL
+#define CLOCK_VREG_SETTLING_US       1000UL
+
+#define CLOCK_PLL_POSTDIV_MAX        7UL
+
+//=============================================================================
+// Globals
+//=============================================================================
+static uint32 u32ClockDvfsSysFreqHz = CLOCK_SYS_FREQ_HZ;
+static uint32 u32ClockDvfsNotifierCount = 0;
+static clockDvfsNotifier_t ClockDvfsNotifiers[CLOCK_DVFS_NOTIFIER_MAX];
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static boolean RP2350_ClockDvfsSolve(uint32 FreqHz, clockPllCfg_t* pPllCfg);
+static void    RP2350_ClockDvfsNotify(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz);
+static uint32  RP2350_ClockGetCoreVoltage(void);
+static void    RP2350_ClockWaitUs(uint32 Us);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDvfsRegisterNotifier function
+///
+/// \descr  To be called during the initialization, before the first frequency change.
+///
+/// \param  Notifier : the function called before and after each clk_sys change
+///
+/// \return TRUE if registered, FALSE if the notifier table is full
+//-----------------------------------------------------------------------------------------
+boolean RP2350_ClockDvfsRegisterNotifier(clockDvfsNotifier_t Notifier)
+{
+  boolean Status = FALSE;
+
+  if((Notifier != (clockDvfsNotifier_t)0) && (u32ClockDvfsNotifierCount < CLOCK_DVFS_NOTIFIER_MAX))
+  {
+    ClockDvfsNotifiers[u32ClockDvfsNotifierCount] = Notifier;
+    u32ClockDvfsNotifierCount++;
+    Status = TRUE;
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDvfsSetSysFreq function
+///
+/// \descr  Change clk_sys at runtime (same divider rules as the build-time solver).
+///         Not reentrant: the frequency must be changed from one core only.
+///
+/// \param  FreqHz : the new clk_sys frequency
+///
+/// \return TRUE on success, FALSE if the frequency is not reachable (nothing changed)
+//-----------------------------------------------------------------------------------------
+boolean RP2350_ClockDvfsSetSysFreq(uint32 FreqHz)
+{
+  clockPllCfg_t PllCfg;
+  boolean Status         = TRUE;
+  const uint32 OldFreqHz = u32ClockDvfsSysFreqHz;
+
+  if(FreqHz != OldFreqHz)
+  {
+    if((FreqHz > CLOCK_SYS_FREQ_MAX_HZ) || (FALSE == RP2350_ClockDvfsSolve(FreqHz, &PllCfg)))
+    {
+      Status = FALSE;
+    }
+    else
+    {
+      const uint32 VoltageMv = CLOCK_VREG_MV(FreqHz);
+
+      RP2350_ClockDvfsNotify(CLOCK_DVFS_PRE_CHANGE, OldFreqHz, FreqHz);
+
+      /* Voltage up before the frequency increase */
+      if(VoltageMv > RP2350_ClockGetCoreVoltage())
+      {
+        RP2350_ClockSetCoreVoltage(VoltageMv);
+      }
+
+      RP2350_ClockSysSelectRef();
+      RP2350_ClockPllSysConfigure(&PllCfg);
+      RP2350_ClockSysSelectPllSys();
+
+      /* Voltage down after the frequency decrease */
+      if(VoltageMv < RP2350_ClockGetCoreVoltage())
+      {
+        RP2350_ClockSetCoreVoltage(VoltageMv);
+      }
+
+      u32ClockDvfsSysFreqHz = FreqHz;
+
+      RP2350_ClockDvfsNotify(CLOCK_DVFS_POST_CHANGE, OldFreqHz, FreqHz);
+    }
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDvfsGetSysFreq function
+///
+/// \param  void
+///
+/// \return the current clk_sys frequency in Hz
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_ClockDvfsGetSysFreq(void)
+{
+  return(u32ClockDvfsSysFreqHz);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockSetCoreVoltage function
+///
+/// \descr  Program the VREG output and wait for it to settle. Also used by the
+///         clock bring-up before the RAM initialization: no global is accessed.
+///
+/// \param  VoltageMv : 550..1300 mV (50 mV steps)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_ClockSetCoreVoltage(uint32 VoltageMv)
+{
+  VoltageMv = (VoltageMv < CLOCK_VREG_MIN_MV) ? CLOCK_VREG_MIN_MV : VoltageMv;
+  VoltageMv = (VoltageMv > CLOCK_VREG_MAX_MV) ? CLOCK_VREG_MAX_MV : VoltageMv;
+
+  const uint32 Vsel = (VoltageMv - CLOCK_VREG_MIN_MV) / CLOCK_VREG_STEP_MV;
+
+  while(HW_PER_POWMAN->VREG.bit.UPDATE_IN_PROGRESS != 0U);
+
+  /* the POWMAN registers are only written with the password in the upper half-word */
+  HW_PER_POWMAN->VREG.reg = CLOCK_POWMAN_PASSWORD
+                          | (HW_PER_POWMAN->VREG.reg & ~(CLOCK_POWMAN_PASSWORD_MSK | CLOCK_VREG_VSEL_MSK))
+                          | (Vsel << CLOCK_VREG_VSEL_POS);
+
+  while(HW_PER_POWMAN->VREG.bit.UPDATE_IN_PROGRESS != 0U);
+
+  RP2350_ClockWaitUs(CLOCK_VREG_SETTLING_US);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockScale function
+///
+/// \descr  Value * Numerator / Denominator with a 64-bit intermediate product, without
+///         the libgcc 64-bit division (the image is linked with -nostdlib).
+///
+/// \param  Value       : the value to scale (e.g. a cycle count at the old frequency)
+///         Numerator   : e.g. the new frequency
+///         Denominator : e.g. the old frequency
+///
+/// \return the scaled value (saturated to 0xFFFFFFFF)
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_ClockScale(uint32 Value, uint32 Numerator, uint32 Denominator)
+{
+  return(RP2350_ClockDivide((uint64)Value * (uint64)Numerator, Denominator));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDivide function
+///
+/// \descr  64-bit by 32-bit division without the libgcc 64-bit division (the image is
+///         linked with -nostdlib), e.g. the average of a 64-bit cycle sum.
+///
+/// \param  Dividend : the 64-bit value
+///         Divisor  : the divisor
+///
+/// \return Dividend / Divisor (saturated to 0xFFFFFFFF, 0xFFFFFFFF if Divisor is 0)
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_ClockDivide(uint64 Dividend, uint32 Divisor)
+{
+  uint64 Quotient  = (Divisor == 0UL) ? 0xFFFFFFFFULL : 0ULL;
+  uint64 Remainder = 0ULL;
+
+  for(uint32 bit = 0UL; (Divisor != 0UL) && (bit < 64UL); bit++)
+  {
+    Remainder = (Remainder << 1) | (Dividend >> 63);
+    Dividend  = Dividend << 1;
+    Quotient  = Quotient << 1;
+
+    if(Remainder >= (uint64)Divisor)
+    {
+      Remainder -= (uint64)Divisor;
+      Quotient  |= 1ULL;
+    }
+  }
+
+  return((Quotient > 0xFFFFFFFFULL) ? (uint32)-1 : (uint32)Quotient);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDvfsSolve function
+///
+/// \descr  Runtime counterpart of the Clock_Cfg.h solver: highest legal VCO first,
+///         POSTDIV1 >= POSTDIV2, fixed REFDIV.
+///
+/// \param  FreqHz  : the clk_sys target
+///         pPllCfg : the PLL_SYS dividers (output)
+///
+/// \return TRUE if the target is reachable exactly
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockDvfsSolve(uint32 FreqHz, clockPllCfg_t* pPllCfg)
+{
+  uint32 BestVcoHz = 0UL;
+
+  for(uint32 PostDiv1 = CLOCK_PLL_POSTDIV_MAX; PostDiv1 > 0UL; PostDiv1--)
+  {
+    for(uint32 PostDiv2 = PostDiv1; PostDiv2 > 0UL; PostDiv2--)
+    {
+      /* skip before the product overflows */
+      if((FreqHz == 0UL) || (FreqHz > (CLOCK_PLL_VCO_MAX_HZ / (PostDiv1 * PostDiv2))))
+      {
+        continue;
+      }
+
+      const uint32 VcoHz = FreqHz * PostDiv1 * PostDiv2;
+      const uint32 FbDiv = VcoHz / CLOCK_PLL_SYS_REF_HZ;
+
+      if(((VcoHz % CLOCK_PLL_SYS_REF_HZ) == 0UL) &&
+         (VcoHz >= CLOCK_PLL_VCO_MIN_HZ)         &&
+         (FbDiv >= CLOCK_PLL_FBDIV_MIN)          &&
+         (FbDiv <= CLOCK_PLL_FBDIV_MAX)          &&
+         (VcoHz > BestVcoHz))
+      {
+        BestVcoHz         = VcoHz;
+        pPllCfg->RefDiv   = CLOCK_PLL_SYS_REFDIV;
+        pPllCfg->FbDiv    = FbDiv;
+        pPllCfg->PostDiv1 = PostDiv1;
+        pPllCfg->PostDiv2 = PostDiv2;
+      }
+    }
+  }
+
+  return((BestVcoHz != 0UL) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockDvfsNotify function
+///
+/// \param  Event     : CLOCK_DVFS_PRE_CHANGE or CLOCK_DVFS_POST_CHANGE
+///         OldFreqHz : clk_sys before the change
+///         NewFreqHz : clk_sys after the change
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockDvfsNotify(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz)
+{
+  for(uint32 idx = 0UL; idx < u32ClockDvfsNotifierCount; idx++)
+  {
+    ClockDvfsNotifiers[idx](Event, OldFreqHz, NewFreqHz);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockGetCoreVoltage function
+///
+/// \param  void
+///
+/// \return the programmed VREG output in mV (values above 1.30 V are reported as 1.30 V)
+//-----------------------------------------------------------------------------------------
+static uint32 RP2350_ClockGetCoreVoltage(void)
+{
+  uint32 Vsel = (uint32)HW_PER_POWMAN->VREG.bit.VSEL;
+
+  Vsel = (Vsel > CLOCK_VREG_VSEL_LINEAR_MAX) ? CLOCK_VREG_VSEL_LINEAR_MAX : Vsel;
+
+  return(CLOCK_VREG_MIN_MV + (Vsel * CLOCK_VREG_STEP_MV));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockWaitUs function
+///
+/// \descr  Busy wait on the TIMER0 raw counter (1 us tick from clk_ref, independent
+///         of clk_sys), started by RP2350_ClockTickStart if not running yet.
+///
+/// \param  Us : the wait time in microseconds
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockWaitUs(uint32 Us)
+{
+  RP2350_ClockTickStart();
+
+  const uint32 Start = HW_PER_TIMER0->TIMERAWL.reg;
+
+  while((HW_PER_TIMER0->TIMERAWL.reg - Start) < Us);
+}
@@ -0,0 +1,52 @@
+/******************************************************************************************
+  Filename    : ClockDvfs.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Runtime clk_sys scaling (DVFS) header file for RP2350
+  
+******************************************************************************************/
+#ifndef __RP2350_CLOCK_DVFS_H__
+#define __RP2350_CLOCK_DVFS_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define CLOCK_DVFS_NOTIFIER_MAX   8U
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef enum
+{
+  CLOCK_DVFS_PRE_CHANGE = 0,  /* clk_sys is still at OldFreqHz */
+  CLOCK_DVFS_POST_CHANGE      /* clk_sys runs at NewFreqHz */
+}clockDvfsEvent_t;
+
+/* Called on the core which requested the change, must not change the clock itself */
+typedef void (*clockDvfsNotifier_t)(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz);
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+boolean RP2350_ClockDvfsRegisterNotifier(clockDvfsNotifier_t Notifier);
+boolean RP2350_ClockDvfsSetSysFreq(uint32 FreqHz);
+uint32  RP2350_ClockDvfsGetSysFreq(void);
+void    RP2350_ClockSetCoreVoltage(uint32 VoltageMv);
+uint32  RP2350_ClockScale(uint32 Value, uint32 Numerator, uint32 Denominator);
+uint32  RP2350_ClockDivide(uint64 Dividend, uint32 Divisor);
+
+#endif /*__RP2350_CLOCK_DVFS_H__*/
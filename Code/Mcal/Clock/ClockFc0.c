@@ -0,0 +1,173 @@
+/******************************************************************************************
+  Filename    : ClockFc0.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : CLOCKS FC0 frequency counter for RP2350
+  
+                The counter uses clk_ref as time base: it must run from the XOSC
+                (after RP2350_ClockInit). RP2350_ClockFc0Start/Poll do not block,
+                the measurement time is set by the interval (CLOCK_FC0_INTERVAL_xxx).
+  
+                The clocks are checked once at boot (INIT_LEVEL_POST_CLOCK), the
+                result is kept in ClockFc0_BootReport.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "ClockFc0.h"
+#include "ClockDvfs.h"
+#include "Clock_Cfg.h"
+#include "InitLevel.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define CLOCK_FC0_REF_KHZ           (CLOCK_XOSC_FREQ_HZ / 1000UL)
+#define CLOCK_FC0_MAX_KHZ           0x01FFFFFFUL
+#define CLOCK_FC0_INTERVAL_MAX      15UL
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile clockFc0Report_t ClockFc0_BootReport;
+
+static volatile boolean boClockFc0Started = FALSE;
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void    RP2350_ClockFc0BootCheck(void);
+static boolean RP2350_ClockFc0InRange(uint32 MeasuredKhz, uint32 ExpectedKhz);
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(RP2350_ClockFc0BootCheck, INIT_LEVEL_POST_CLOCK, 100);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockFc0Start function
+///
+/// \param  Src      : the clock to measure
+///         Interval : CLOCK_FC0_INTERVAL_xxx (0..15), longer is more accurate
+///
+/// \return FALSE if a measurement is already running
+//-----------------------------------------------------------------------------------------
+boolean RP2350_ClockFc0Start(clockFc0Src_t Src, uint32 Interval)
+{
+  boolean Status = FALSE;
+
+  if(HW_PER_CLOCKS->FC0_STATUS.bit.RUNNING == 0U)
+  {
+    HW_PER_CLOCKS->FC0_REF_KHZ.reg  = CLOCK_FC0_REF_KHZ;
+    HW_PER_CLOCKS->FC0_INTERVAL.reg = (Interval > CLOCK_FC0_INTERVAL_MAX) ? CLOCK_FC0_INTERVAL_MAX : Interval;
+    HW_PER_CLOCKS->FC0_MIN_KHZ.reg  = 0UL;
+    HW_PER_CLOCKS->FC0_MAX_KHZ.reg  = CLOCK_FC0_MAX_KHZ;
+
+    /* writing the source starts the measurement */
+    HW_PER_CLOCKS->FC0_SRC.reg = (uint32)Src;
+
+    boClockFc0Started = TRUE;
+    Status            = TRUE;
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockFc0Poll function
+///
+/// \param  pFreqKhz : the measured frequency in kHz (written when DONE is returned)
+///
+/// \return CLOCK_FC0_DONE once per measurement, CLOCK_FC0_BUSY while it runs
+//-----------------------------------------------------------------------------------------
+clockFc0Status_t RP2350_ClockFc0Poll(uint32* pFreqKhz)
+{
+  clockFc0Status_t Status = CLOCK_FC0_IDLE;
+
+  if(TRUE == boClockFc0Started)
+  {
+    if(HW_PER_CLOCKS->FC0_STATUS.bit.DONE == 1U)
+    {
+      /* a stopped clock gives 0 kHz */
+      *pFreqKhz         = (uint32)HW_PER_CLOCKS->FC0_RESULT.bit.KHZ;
+      boClockFc0Started = FALSE;
+      Status            = CLOCK_FC0_DONE;
+    }
+    else
+    {
+      Status = CLOCK_FC0_BUSY;
+    }
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockFc0MeasureKhz function
+///
+/// \descr  Blocking measurement (waits for a running measurement to end first).
+///
+/// \param  Src      : the clock to measure
+///         Interval : CLOCK_FC0_INTERVAL_xxx (0..15), longer is more accurate
+///
+/// \return the measured frequency in kHz
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_ClockFc0MeasureKhz(clockFc0Src_t Src, uint32 Interval)
+{
+  uint32 FreqKhz = 0UL;
+
+  while(FALSE == RP2350_ClockFc0Start(Src, Interval));
+
+  while(CLOCK_FC0_DONE != RP2350_ClockFc0Poll(&FreqKhz));
+
+  return(FreqKhz);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockFc0BootCheck function
+///
+/// \descr  Measure the main clocks right after the clock and RAM initialization.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void RP2350_ClockFc0BootCheck(void)
+{
+  ClockFc0_BootReport.RefKhz  = RP2350_ClockFc0MeasureKhz(CLOCK_FC0_SRC_CLK_REF,  CLOCK_FC0_INTERVAL_128US);
+  ClockFc0_BootReport.SysKhz  = RP2350_ClockFc0MeasureKhz(CLOCK_FC0_SRC_CLK_SYS,  CLOCK_FC0_INTERVAL_128US);
+  ClockFc0_BootReport.PeriKhz = RP2350_ClockFc0MeasureKhz(CLOCK_FC0_SRC_CLK_PERI, CLOCK_FC0_INTERVAL_128US);
+  ClockFc0_BootReport.UsbKhz  = RP2350_ClockFc0MeasureKhz(CLOCK_FC0_SRC_CLK_USB,  CLOCK_FC0_INTERVAL_128US);
+
+  ClockFc0_BootReport.Pass = ((TRUE == RP2350_ClockFc0InRange(ClockFc0_BootReport.RefKhz, CLOCK_FC0_REF_KHZ)) &&
+                              (TRUE == RP2350_ClockFc0InRange(ClockFc0_BootReport.SysKhz, RP2350_ClockDvfsGetSysFreq() / 1000UL))) ? 1UL : 0UL;
+
+  ClockFc0_BootReport.Done = 1UL;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_ClockFc0InRange function
+///
+/// \param  MeasuredKhz : the measured frequency
+///         ExpectedKhz : the expected frequency
+///
+/// \return TRUE if the difference is within CLOCK_FC0_CHECK_TOLERANCE_KHZ
+//-----------------------------------------------------------------------------------------
+static boolean RP2350_ClockFc0InRange(uint32 MeasuredKhz, uint32 ExpectedKhz)
+{
+  const uint32 Difference = (MeasuredKhz > ExpectedKhz) ? (MeasuredKhz - ExpectedKhz) : (ExpectedKhz - MeasuredKhz);
+
+  return((Difference <= CLOCK_FC0_CHECK_TOLERANCE_KHZ) ? TRUE : FALSE);
+}
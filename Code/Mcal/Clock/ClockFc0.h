@@ -0,0 +1,84 @@
+/******************************************************************************************
+  Filename    : ClockFc0.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : CLOCKS FC0 frequency counter header file for RP2350
+  
+******************************************************************************************/
+#ifndef __RP2350_CLOCK_FC0_H__
+#define __RP2350_CLOCK_FC0_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* FC0 test interval: 2^n clk_ref-us, the resolution is 1 / interval */
+#define CLOCK_FC0_INTERVAL_16US    4UL   /* +/- 62.5 kHz */
+#define CLOCK_FC0_INTERVAL_128US   7UL   /* +/- 7.8 kHz */
+#define CLOCK_FC0_INTERVAL_1MS     10UL  /* +/- 1 kHz */
+#define CLOCK_FC0_INTERVAL_32MS    15UL  /* +/- 31 Hz */
+
+/* tolerance of the boot check on clk_sys and clk_ref */
+#define CLOCK_FC0_CHECK_TOLERANCE_KHZ   100UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef enum
+{
+  CLOCK_FC0_SRC_PLL_SYS  = 0x01,
+  CLOCK_FC0_SRC_PLL_USB  = 0x02,
+  CLOCK_FC0_SRC_ROSC     = 0x03,
+  CLOCK_FC0_SRC_XOSC     = 0x05,
+  CLOCK_FC0_SRC_CLK_REF  = 0x08,
+  CLOCK_FC0_SRC_CLK_SYS  = 0x09,
+  CLOCK_FC0_SRC_CLK_PERI = 0x0A,
+  CLOCK_FC0_SRC_CLK_USB  = 0x0B,
+  CLOCK_FC0_SRC_CLK_ADC  = 0x0C,
+  CLOCK_FC0_SRC_CLK_HSTX = 0x0D,
+  CLOCK_FC0_SRC_LPOSC    = 0x0E
+}clockFc0Src_t;
+
+typedef enum
+{
+  CLOCK_FC0_IDLE = 0,  /* no measurement started */
+  CLOCK_FC0_BUSY,      /* measurement running */
+  CLOCK_FC0_DONE       /* result available */
+}clockFc0Status_t;
+
+typedef struct
+{
+  uint32 Done;      /* 1 once the boot check was executed */
+  uint32 RefKhz;
+  uint32 SysKhz;
+  uint32 PeriKhz;
+  uint32 UsbKhz;    /* 0 while clk_usb is not enabled */
+  uint32 Pass;      /* 1 if clk_ref and clk_sys are within CLOCK_FC0_CHECK_TOLERANCE_KHZ */
+}clockFc0Report_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+extern volatile clockFc0Report_t ClockFc0_BootReport;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+boolean          RP2350_ClockFc0Start(clockFc0Src_t Src, uint32 Interval);
+clockFc0Status_t RP2350_ClockFc0Poll(uint32* pFreqKhz);
+uint32           RP2350_ClockFc0MeasureKhz(clockFc0Src_t Src, uint32 Interval);
+
+#endif /*__RP2350_CLOCK_FC0_H__*/
@@ -0,0 +1,196 @@
+/******************************************************************************************
+  Filename    : Clock_Cfg.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Clock configuration for RP2350 (build-time PLL_SYS solver)
+  
+                The system clock target is given by CLOCK_CFG_SYS_FREQ_HZ (make CLOCK_SYS_HZ=...).
+                The PLL_SYS dividers are selected by the preprocessor among the legal
+                values and the build fails if the target cannot be reached exactly.
+                All the timing macros must derive from CLOCK_SYS_FREQ_HZ.
+  
+                Targets above the 150 MHz rating run with a raised core voltage, see
+                CLOCK_VREG_MV() (applied by the clock bring-up and the DVFS API).
+  
+******************************************************************************************/
+#ifndef __RP2350_CLOCK_CFG_H__
+#define __RP2350_CLOCK_CFG_H__
+
+//=============================================================================
+// Configuration
+//=============================================================================
+#ifndef CLOCK_CFG_XOSC_FREQ_HZ
+  #define CLOCK_CFG_XOSC_FREQ_HZ     12000000UL
+#endif
+
+#ifndef CLOCK_CFG_SYS_FREQ_HZ
+  #define CLOCK_CFG_SYS_FREQ_HZ      150000000UL
+#endif
+
+#ifndef CLOCK_CFG_PLL_SYS_REFDIV
+  #define CLOCK_CFG_PLL_SYS_REFDIV   1UL
+#endif
+
+//=============================================================================
+// PLL_SYS limits (RP2350 datasheet, PLL chapter)
+//=============================================================================
+#define CLOCK_PLL_REF_MIN_HZ       5000000UL
+#define CLOCK_PLL_VCO_MIN_HZ       750000000UL
+#define CLOCK_PLL_VCO_MAX_HZ       1600000000UL
+#define CLOCK_PLL_FBDIV_MIN        16UL
+#define CLOCK_PLL_FBDIV_MAX        320UL
+
+#define CLOCK_PLL_SYS_REF_HZ       (CLOCK_CFG_XOSC_FREQ_HZ / CLOCK_CFG_PLL_SYS_REFDIV)
+
+//=============================================================================
+// Core voltage (VREG) versus clk_sys
+//=============================================================================
+/* never below the 1.10 V reset value, 1.30 V is the highest voltage without unlocking */
+#define CLOCK_SYS_FREQ_NOMINAL_HZ  150000000UL
+#define CLOCK_SYS_FREQ_MAX_HZ      300000000UL
+#define CLOCK_VREG_NOMINAL_MV      1100UL
+
+#define CLOCK_VREG_MV(hz)          (((hz) <= CLOCK_SYS_FREQ_NOMINAL_HZ) ? CLOCK_VREG_NOMINAL_MV : \
+                                    ((hz) <= 200000000UL)               ? 1150UL                : \
+                                    ((hz) <= 250000000UL)               ? 1200UL                : 1300UL)
+
+#if (CLOCK_CFG_SYS_FREQ_HZ > CLOCK_SYS_FREQ_MAX_HZ)
+  #error "Clock_Cfg.h: CLOCK_CFG_SYS_FREQ_HZ is above CLOCK_SYS_FREQ_MAX_HZ"
+#endif
+
+#if ((CLOCK_CFG_XOSC_FREQ_HZ % 1000000UL) != 0UL)
+  #error "Clock_Cfg.h: the XOSC frequency must be an integer number of MHz (TICKS generators)"
+#endif
+
+#if ((CLOCK_CFG_XOSC_FREQ_HZ % CLOCK_CFG_PLL_SYS_REFDIV) != 0UL) || (CLOCK_PLL_SYS_REF_HZ < CLOCK_PLL_REF_MIN_HZ)
+  #error "Clock_Cfg.h: invalid PLL_SYS REFDIV for the XOSC frequency"
+#endif
+
+//=============================================================================
+// PLL_SYS solver
+//=============================================================================
+/* clk_sys = REF * FBDIV / (POSTDIV1 * POSTDIV2), the candidate is legal if FBDIV is an   */
+/* integer in range and the VCO is in range. The post dividers are tried from the highest */
+/* product (highest VCO, lowest jitter) with POSTDIV1 >= POSTDIV2 as recommended.          */
+#define CLOCK_PLL_SYS_VCO_HZ(pd1, pd2)      (CLOCK_CFG_SYS_FREQ_HZ * (pd1) * (pd2))
+
+#define CLOCK_PLL_SYS_CANDIDATE(pd1, pd2)                                              \
+  (   ((CLOCK_PLL_SYS_VCO_HZ(pd1, pd2) % CLOCK_PLL_SYS_REF_HZ) == 0UL)                 \
+   && (CLOCK_PLL_SYS_VCO_HZ(pd1, pd2) >= CLOCK_PLL_VCO_MIN_HZ)                         \
+   && (CLOCK_PLL_SYS_VCO_HZ(pd1, pd2) <= CLOCK_PLL_VCO_MAX_HZ)                         \
+   && ((CLOCK_PLL_SYS_VCO_HZ(pd1, pd2) / CLOCK_PLL_SYS_REF_HZ) >= CLOCK_PLL_FBDIV_MIN) \
+   && ((CLOCK_PLL_SYS_VCO_HZ(pd1, pd2) / CLOCK_PLL_SYS_REF_HZ) <= CLOCK_PLL_FBDIV_MAX))
+
+#if   CLOCK_PLL_SYS_CANDIDATE(7, 7)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   7UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 6)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   6UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 6)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   6UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 5)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   5UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 5)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   5UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 4)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   4UL
+#elif CLOCK_PLL_SYS_CANDIDATE(5, 5)
+  #define CLOCK_PLL_SYS_POSTDIV1   5UL
+  #define CLOCK_PLL_SYS_POSTDIV2   5UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 4)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   4UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 3)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   3UL
+#elif CLOCK_PLL_SYS_CANDIDATE(5, 4)
+  #define CLOCK_PLL_SYS_POSTDIV1   5UL
+  #define CLOCK_PLL_SYS_POSTDIV2   4UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 3)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   3UL
+#elif CLOCK_PLL_SYS_CANDIDATE(4, 4)
+  #define CLOCK_PLL_SYS_POSTDIV1   4UL
+  #define CLOCK_PLL_SYS_POSTDIV2   4UL
+#elif CLOCK_PLL_SYS_CANDIDATE(5, 3)
+  #define CLOCK_PLL_SYS_POSTDIV1   5UL
+  #define CLOCK_PLL_SYS_POSTDIV2   3UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(4, 3)
+  #define CLOCK_PLL_SYS_POSTDIV1   4UL
+  #define CLOCK_PLL_SYS_POSTDIV2   3UL
+#elif CLOCK_PLL_SYS_CANDIDATE(5, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   5UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(3, 3)
+  #define CLOCK_PLL_SYS_POSTDIV1   3UL
+  #define CLOCK_PLL_SYS_POSTDIV2   3UL
+#elif CLOCK_PLL_SYS_CANDIDATE(4, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   4UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(7, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   7UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(6, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   6UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(3, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   3UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(5, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   5UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(4, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   4UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(2, 2)
+  #define CLOCK_PLL_SYS_POSTDIV1   2UL
+  #define CLOCK_PLL_SYS_POSTDIV2   2UL
+#elif CLOCK_PLL_SYS_CANDIDATE(3, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   3UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(2, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   2UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#elif CLOCK_PLL_SYS_CANDIDATE(1, 1)
+  #define CLOCK_PLL_SYS_POSTDIV1   1UL
+  #define CLOCK_PLL_SYS_POSTDIV2   1UL
+#else
+  #error "Clock_Cfg.h: CLOCK_CFG_SYS_FREQ_HZ cannot be reached exactly by the PLL_SYS"
+#endif
+
+#define CLOCK_PLL_SYS_REFDIV       CLOCK_CFG_PLL_SYS_REFDIV
+#define CLOCK_PLL_SYS_FBDIV        (CLOCK_PLL_SYS_VCO_HZ(CLOCK_PLL_SYS_POSTDIV1, CLOCK_PLL_SYS_POSTDIV2) / CLOCK_PLL_SYS_REF_HZ)
+
+//=============================================================================
+// Published frequencies
+//=============================================================================
+#define CLOCK_XOSC_FREQ_HZ         CLOCK_CFG_XOSC_FREQ_HZ
+#define CLOCK_XOSC_FREQ_MHZ        (CLOCK_XOSC_FREQ_HZ / 1000000UL)
+
+/* clk_sys (= clk_cpu), computed back from the selected dividers */
+#define CLOCK_SYS_FREQ_HZ          ((CLOCK_PLL_SYS_REF_HZ * CLOCK_PLL_SYS_FBDIV) / (CLOCK_PLL_SYS_POSTDIV1 * CLOCK_PLL_SYS_POSTDIV2))
+
+/* XOSC startup delay: ~1 ms in units of 256 XOSC cycles */
+#define CLOCK_XOSC_STARTUP_DELAY   (((CLOCK_XOSC_FREQ_HZ / 1000UL) + 128UL) / 256UL)
+
+#endif /*__RP2350_CLOCK_CFG_H__*/
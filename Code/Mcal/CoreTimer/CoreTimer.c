@@ -0,0 +1,412 @@
+/******************************************************************************************
+  Filename    : CoreTimer.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Core-local periodic / one-shot timer implementation
+  
+                RISC-V: MTIME is shared by the cores, MTIMECMP is private to each core
+                (SIO core-local). On RV32 the 64-bit MTIMECMP is written with the
+                sequence of the privileged spec (low word to all-ones first) so that
+                no intermediate value can raise a spurious interrupt.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "CoreTimer.h"
+#include "Compiler.h"
+#include "Clock_Cfg.h"
+#include "InitLevel.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+#if defined(CORE_FAMILY_ARM)
+  #include "SysTickTimer.h"
+#endif
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define CORE_TIMER_CORE_ID()        ((uint32)HW_PER_SIO->CPUID.reg)
+
+#if defined(CORE_FAMILY_RISC_V)
+  #define CORE_TIMER_LATE_MAX       0x7FFFFFFFUL
+#endif
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  coreTimerCallback_t Callback;
+  uint32              PeriodUs;     /* 0: one-shot */
+  boolean             Running;
+#if defined(CORE_FAMILY_RISC_V)
+  uint64              DeadlineUs;   /* programmed MTIMECMP */
+#endif
+}coreTimer_t;
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void CoreTimer_InitCore1(void);
+static void CoreTimer_HwInit(uint32 Core);
+static void CoreTimer_HwStart(coreTimer_t* pTimer, uint32 TimeoutUs);
+static void CoreTimer_HwStop(void);
+
+#if defined(CORE_FAMILY_RISC_V)
+  static uint64 CoreTimer_ReadMtime(void) __time_critical;
+  static void   CoreTimer_WriteMtimecmp(uint64 Value) __time_critical;
+  __attribute__((interrupt)) void Isr_MachineTimerInterrupt(void) __time_critical;
+#else
+  void SysTickTimer(void) __time_critical;
+#endif
+
+//=============================================================================
+// Globals
+//=============================================================================
+static coreTimer_t CoreTimer[CORE_TIMER_CORES];
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(CoreTimer_Init, INIT_LEVEL_POST_CLOCK, 30);
+INIT_LEVEL_REGISTER(CoreTimer_InitCore1, INIT_LEVEL_DEFERRED, 10);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_Init function
+///
+/// \descr  Stop the timer of the calling core and start its 1 us tick.
+///         Executed at INIT_LEVEL_POST_CLOCK (core 0) and INIT_LEVEL_DEFERRED (core 1).
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void CoreTimer_Init(void)
+{
+  const uint32 Core = CORE_TIMER_CORE_ID();
+
+  CoreTimer_HwInit(Core);
+
+  CoreTimer[Core].Callback = NULL;
+  CoreTimer[Core].PeriodUs = 0UL;
+  CoreTimer[Core].Running  = FALSE;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_Start function
+///
+/// \descr  (Re)start the timer of the calling core
+///
+/// \param  TimeoutUs : period or one-shot timeout (CORE_TIMER_MIN_US..CORE_TIMER_MAX_US)
+///         Mode      : CORE_TIMER_ONE_SHOT or CORE_TIMER_PERIODIC
+///         Callback  : expiry callback (timer interrupt)
+///
+/// \return TRUE if the timer is started
+//-----------------------------------------------------------------------------------------
+boolean CoreTimer_Start(uint32 TimeoutUs, coreTimerMode_t Mode, coreTimerCallback_t Callback)
+{
+  boolean Started = FALSE;
+
+  if((Callback != NULL) && (TimeoutUs >= CORE_TIMER_MIN_US) && (TimeoutUs <= CORE_TIMER_MAX_US))
+  {
+    coreTimer_t* pTimer = &CoreTimer[CORE_TIMER_CORE_ID()];
+
+    CoreTimer_HwStop();
+
+    pTimer->Callback = Callback;
+    pTimer->PeriodUs = (Mode == CORE_TIMER_PERIODIC) ? TimeoutUs : 0UL;
+    pTimer->Running  = TRUE;
+
+    CoreTimer_HwStart(pTimer, TimeoutUs);
+
+    Started = TRUE;
+  }
+
+  return(Started);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_Stop function
+///
+/// \descr  Stop the timer of the calling core, a pending expiry is discarded
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void CoreTimer_Stop(void)
+{
+  CoreTimer_HwStop();
+
+  CoreTimer[CORE_TIMER_CORE_ID()].Running = FALSE;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_IsRunning function
+///
+/// \param  void
+///
+/// \return TRUE while the timer of the calling core is running
+//-----------------------------------------------------------------------------------------
+boolean CoreTimer_IsRunning(void)
+{
+  return(CoreTimer[CORE_TIMER_CORE_ID()].Running);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_InitCore1 function
+///
+/// \descr  Executed at INIT_LEVEL_DEFERRED (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_InitCore1(void)
+{
+  CoreTimer_Init();
+}
+
+#if defined(CORE_FAMILY_ARM)
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwInit function
+///
+/// \descr  SysTick clocked by the external reference: the PROC0/PROC1 1 us tick
+///
+/// \param  Core : calling core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwInit(uint32 Core)
+{
+  if(Core == 0UL)
+  {
+    HW_PER_TICKS->PROC0_CYCLES.bit.PROC0_CYCLES = CLOCK_XOSC_FREQ_MHZ;
+    HW_PER_TICKS->PROC0_CTRL.bit.ENABLE         = 1U;
+  }
+  else
+  {
+    HW_PER_TICKS->PROC1_CYCLES.bit.PROC1_CYCLES = CLOCK_XOSC_FREQ_MHZ;
+    HW_PER_TICKS->PROC1_CTRL.bit.ENABLE         = 1U;
+  }
+
+  SysTickTimer_Init();
+
+  pSTK_CTRL->bits.u1CLOCKSRC = SYS_TICK_CLKSRC_EXTERNAL_REFERENCE_CLOCK;
+
+  SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwStart function
+///
+/// \descr  The SysTick reloads by hardware: a periodic timer is never re-programmed
+///
+/// \param  pTimer    : timer of the calling core
+///         TimeoutUs : first timeout (and period)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwStart(coreTimer_t* pTimer, uint32 TimeoutUs)
+{
+  (void)pTimer;
+
+  SysTickTimer_Start(TimeoutUs - 1UL);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwStop function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwStop(void)
+{
+  SysTickTimer_Stop();
+
+  SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  SysTickTimer function
+///
+/// \descr  SysTick interrupt of the calling core
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void SysTickTimer(void)
+{
+  coreTimer_t* pTimer = &CoreTimer[CORE_TIMER_CORE_ID()];
+
+  if(pTimer->PeriodUs == 0UL)
+  {
+    /* one-shot: stopped before the callback which may restart it */
+    SysTickTimer_Stop();
+
+    pTimer->Running = FALSE;
+  }
+
+  if(pTimer->Callback != NULL)
+  {
+    pTimer->Callback();
+  }
+}
+
+#else
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwInit function
+///
+/// \descr  MTIME counts the shared RISCV 1 us tick (not clk_sys)
+///
+/// \param  Core : calling core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwInit(uint32 Core)
+{
+  (void)Core;
+
+  if(HW_PER_TICKS->RISCV_CTRL.bit.ENABLE != 1U)
+  {
+    HW_PER_TICKS->RISCV_CYCLES.bit.RISCV_CYCLES = CLOCK_XOSC_FREQ_MHZ;
+    HW_PER_TICKS->RISCV_CTRL.bit.ENABLE         = 1U;
+  }
+
+  HW_PER_SIO->MTIME_CTRL.bit.FULLSPEED = 0U;
+
+  CoreTimer_HwStop();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwStart function
+///
+/// \param  pTimer    : timer of the calling core
+///         TimeoutUs : first timeout
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwStart(coreTimer_t* pTimer, uint32 TimeoutUs)
+{
+  pTimer->DeadlineUs = CoreTimer_ReadMtime() + TimeoutUs;
+
+  CoreTimer_WriteMtimecmp(pTimer->DeadlineUs);
+
+  riscv_set_csr(RVCSR_MIE_OFFSET, RVCSR_MIE_MTIE_BITS);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_HwStop function
+///
+/// \descr  MTIMECMP to the maximum: the (level) interrupt request is cleared too
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_HwStop(void)
+{
+  riscv_clear_csr(RVCSR_MIE_OFFSET, RVCSR_MIE_MTIE_BITS);
+
+  CoreTimer_WriteMtimecmp((uint64)-1);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_ReadMtime function
+///
+/// \param  void
+///
+/// \return the 64-bit MTIME (high word read again until stable)
+//-----------------------------------------------------------------------------------------
+static uint64 CoreTimer_ReadMtime(void)
+{
+  uint32 High;
+  uint32 Low;
+
+  do
+  {
+    High = HW_PER_SIO->MTIMEH.reg;
+    Low  = HW_PER_SIO->MTIME.reg;
+  } while(High != HW_PER_SIO->MTIMEH.reg);
+
+  return(((uint64)High << 32) | Low);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  CoreTimer_WriteMtimecmp function
+///
+/// \descr  Tear-free 64-bit write on RV32: with the low word at all-ones first, the
+///         intermediate values are never below the old and the new compare values.
+///         Called with the timer interrupt masked or from the timer interrupt.
+///
+/// \param  Value : new MTIMECMP
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void CoreTimer_WriteMtimecmp(uint64 Value)
+{
+  HW_PER_SIO->MTIMECMP.reg  = (uint32)-1;
+  HW_PER_SIO->MTIMECMPH.reg = (uint32)(Value >> 32);
+  HW_PER_SIO->MTIMECMP.reg  = (uint32)Value;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Isr_MachineTimerInterrupt function
+///
+/// \descr  Machine timer interrupt of the calling core. A periodic deadline advances
+///         by whole periods (no drift), the periods already passed are dropped.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Isr_MachineTimerInterrupt(void)
+{
+  coreTimer_t* pTimer = &CoreTimer[CORE_TIMER_CORE_ID()];
+
+  if(pTimer->PeriodUs != 0UL)
+  {
+    const uint64 Now = CoreTimer_ReadMtime();
+
+    pTimer->DeadlineUs += pTimer->PeriodUs;
+
+    if(pTimer->DeadlineUs <= Now)
+    {
+      const uint32 Late = ((Now - pTimer->DeadlineUs) > CORE_TIMER_LATE_MAX) ? CORE_TIMER_LATE_MAX : (uint32)(Now - pTimer->DeadlineUs);
+
+      pTimer->DeadlineUs += ((Late / pTimer->PeriodUs) + 1UL) * pTimer->PeriodUs;
+    }
+
+    CoreTimer_WriteMtimecmp(pTimer->DeadlineUs);
+  }
+  else
+  {
+    /* one-shot: stopped before the callback which may restart it */
+    CoreTimer_HwStop();
+
+    pTimer->Running = FALSE;
+  }
+
+  if(pTimer->Callback != NULL)
+  {
+    pTimer->Callback();
+  }
+}
+
+#endif
@@ -0,0 +1,64 @@
+/******************************************************************************************
+  Filename    : CoreTimer.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Core-local periodic / one-shot timer header file
+  
+                One timer per core with the same API and semantics on both cores and
+                both architectures:
+                  - ARM    : SysTick of the core on its TICKS reference (PROC0/PROC1),
+                             the periodic mode is the SysTick auto-reload.
+                  - RISC-V : SIO machine timer (MTIME on the RISCV tick, MTIMECMP of
+                             the core), the periodic mode advances MTIMECMP.
+                Both count 1 us ticks from clk_ref: the periods do not depend on clk_sys
+                (no DVFS rescaling). A periodic timer keeps its phase, the periods missed
+                by a late interrupt are dropped (one callback per interrupt).
+  
+******************************************************************************************/
+#ifndef __CORE_TIMER_H__
+#define __CORE_TIMER_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* timeout range, limited by the 24-bit SysTick counter on both architectures */
+#define CORE_TIMER_MIN_US         2UL
+#define CORE_TIMER_MAX_US         0x01000000UL
+
+#define CORE_TIMER_CORES          2UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef enum
+{
+  CORE_TIMER_ONE_SHOT = 0,
+  CORE_TIMER_PERIODIC
+}coreTimerMode_t;
+
+/* called from the timer interrupt of the core which started the timer */
+typedef void (*coreTimerCallback_t)(void);
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    CoreTimer_Init(void);
+boolean CoreTimer_Start(uint32 TimeoutUs, coreTimerMode_t Mode, coreTimerCallback_t Callback);
+void    CoreTimer_Stop(void);
+boolean CoreTimer_IsRunning(void);
+
+#endif /*__CORE_TIMER_H__*/
@@ -19,47 +19,43 @@
 // Includes
 //=============================================================================
 #include "Cpu.h"
+#include "MulticoreBarrier.h"
 #include "core_arch.h"
 
 //=============================================================================
 // Globals
 //=============================================================================
-static uint32 u32MulticoreLock  = 0;
-static volatile uint32 u32MulticoreSync = 0;
+static multicoreBarrier_t Cpu_MulticoreBarrier = MULTICORE_BARRIER_INIT(MULTICORE_SYNC_CORES);
 
 
 //-----------------------------------------------------------------------------------------
 /// \brief  RP2350_MulticoreSync function
 ///
+/// \descr  Wait until both cores reached the synchronization point (reusable, the
+///         waiting core sleeps in WFE / h3.block)
+///
 /// \param  CpuId : The cpu core identifier
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
 void RP2350_MulticoreSync(uint32 CpuId)
 {
-  /* aquire the multicore lock */
-  arch_spin_lock(&u32MulticoreLock);
-
-  u32MulticoreSync |= (1UL << CpuId);
-
-  /* release the multicore lock */
-  arch_spin_unlock(&u32MulticoreLock);
+  (void)CpuId;
 
-  while(u32MulticoreSync != MULTICORE_SYNC_MASK);
+  (void)MulticoreBarrier_Wait(&Cpu_MulticoreBarrier, MULTICORE_BARRIER_NO_TIMEOUT);
 }
 
 //-----------------------------------------------------------------------------------------
-/// \brief  RP2350_StartCore1 function
+/// \brief  RP2350_ResetCore1 function
+///
+/// \descr  Put core 1 back into the BootRom wait loop (known state)
 ///
 /// \param  void
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
-void RP2350_InitCore(void)
+void RP2350_ResetCore1(void)
 {
-  /* we came here from the RP2350 BootRom and SBL */
-  /* Reset core1 to start from a known state */
-
   HW_PER_PSM->FRCE_OFF.bit.PROC1 = 1U;
 
   while((HW_PER_PSM->DONE.bit.PROC1 == 1U));
@@ -67,12 +63,32 @@ void RP2350_InitCore(void)
   HW_PER_PSM->FRCE_OFF.bit.PROC1 = 0U;
 
   while((HW_PER_PSM->DONE.bit.PROC1 != 1U));
+}
 
-  /* Reset peripheral to start from a known state */
-  HW_PER_RESETS->RESET.bit.IO_BANK0   = 1U;
-  HW_PER_RESETS->RESET.bit.PADS_BANK0 = 1U;
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_InitCore function
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_InitCore(void)
+{
+  /* we came here from the RP2350 BootRom and SBL */
+  /* Reset core1 to start from a known state */
+  RP2350_ResetCore1();
 
-  while((HW_PER_RESETS->RESET_DONE.bit.IO_BANK0 == 1U) || (HW_PER_RESETS->RESET_DONE.bit.PADS_BANK0 == 1U));
+  /* Reset peripheral to start from a known state (not needed after a warm reset */
+  /* when they are already out of reset: the application reconfigures its pins)  */
+  if((FALSE == RP2350_IsWarmReset())                 ||
+     (HW_PER_RESETS->RESET_DONE.bit.IO_BANK0   != 1U) ||
+     (HW_PER_RESETS->RESET_DONE.bit.PADS_BANK0 != 1U))
+  {
+    HW_PER_RESETS->RESET.bit.IO_BANK0   = 1U;
+    HW_PER_RESETS->RESET.bit.PADS_BANK0 = 1U;
+
+    while((HW_PER_RESETS->RESET_DONE.bit.IO_BANK0 == 1U) || (HW_PER_RESETS->RESET_DONE.bit.PADS_BANK0 == 1U));
+  }
 
   HW_PER_RESETS->RESET.bit.IO_BANK0   = 0U;
   HW_PER_RESETS->RESET.bit.PADS_BANK0 = 0U;
@@ -81,7 +97,8 @@ void RP2350_InitCore(void)
 
 #ifdef CORE_FAMILY_ARM
   /*Setting EXTEXCLALL allows external exclusive operations to be used in a configuration with no MPU.
-  This is because the default memory map does not include any shareable Normal memory.*/
+  This is because the default memory map does not include any shareable Normal memory.
+  Required by arch_spin_lock and the MULTICORE_LOCK_BACKEND_EXCLUSIVE locks (not by the SIO spinlocks).*/
   SCnSCB->ACTLR |= (1ul<<29);
 #endif
 }
@@ -91,12 +108,30 @@ void RP2350_InitCore(void)
 ///
 /// \param  void
 ///
-/// \return void
+/// \return TRUE if core 1 acknowledged the launch sequence
 //-----------------------------------------------------------------------------------------
 boolean RP2350_StartCore1(void)
 {
   extern uint32 __INTVECT_Core1[2];
 
+  return(RP2350_LaunchCore1((pFunc)__INTVECT_Core1[1]));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_LaunchCore1 function
+///
+/// \descr  Run the BootRom launch protocol on core 1 with the given entry point,
+///         the core 1 vector table and the core 1 stack. The BootRom answers each
+///         word with an event, core 0 sleeps until the answer is there.
+///
+/// \param  EntryPoint : the function executed by core 1
+///
+/// \return TRUE if core 1 acknowledged the launch sequence
+//-----------------------------------------------------------------------------------------
+boolean RP2350_LaunchCore1(pFunc EntryPoint)
+{
+  extern uint32 __INTVECT_Core1[2];
+
   /* Flush the mailbox */
   while(HW_PER_SIO->FIFO_ST.bit.VLD == 1UL)
   {
@@ -107,7 +142,10 @@ boolean RP2350_StartCore1(void)
   HW_PER_SIO->FIFO_WR.reg = 0;
   CORE_ARCH_SEND_EVENT_INST();
 
-  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL);
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
 
   if(HW_PER_SIO->FIFO_RD.reg != 0U)
   {
@@ -118,7 +156,10 @@ boolean RP2350_StartCore1(void)
   HW_PER_SIO->FIFO_WR.reg = 1;
   CORE_ARCH_SEND_EVENT_INST();
 
-  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL);
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
 
   if(HW_PER_SIO->FIFO_RD.reg != 1U)
   {
@@ -129,7 +170,10 @@ boolean RP2350_StartCore1(void)
   HW_PER_SIO->FIFO_WR.reg = (uint32)(&__INTVECT_Core1[0]);
   CORE_ARCH_SEND_EVENT_INST();
 
-  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL);
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
 
   if(HW_PER_SIO->FIFO_RD.reg != (uint32)(&__INTVECT_Core1[0]))
   {
@@ -140,7 +184,10 @@ boolean RP2350_StartCore1(void)
   HW_PER_SIO->FIFO_WR.reg = (uint32)__INTVECT_Core1[0];
   CORE_ARCH_SEND_EVENT_INST();
 
-  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL);
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
 
   if(HW_PER_SIO->FIFO_RD.reg != (uint32)__INTVECT_Core1[0])
   {
@@ -148,13 +195,16 @@ boolean RP2350_StartCore1(void)
   }
 
   /* Send the reset handler */
-  HW_PER_SIO->FIFO_WR.reg = (uint32)__INTVECT_Core1[1];
+  HW_PER_SIO->FIFO_WR.reg = (uint32)EntryPoint;
   CORE_ARCH_SEND_EVENT_INST();
 
-  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL);
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
 
 
-  if(HW_PER_SIO->FIFO_RD.reg != (uint32)__INTVECT_Core1[1])
+  if(HW_PER_SIO->FIFO_RD.reg != (uint32)EntryPoint)
   {
     return(FALSE);
   }
@@ -165,3 +215,73 @@ boolean RP2350_StartCore1(void)
   return(TRUE);
 }
 
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_FifoPush function
+///
+/// \param  Data : the word to send to the other core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_FifoPush(uint32 Data)
+{
+  while(HW_PER_SIO->FIFO_ST.bit.RDY != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
+
+  HW_PER_SIO->FIFO_WR.reg = Data;
+  CORE_ARCH_SEND_EVENT_INST();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_FifoPop function
+///
+/// \param  void
+///
+/// \return the word received from the other core
+//-----------------------------------------------------------------------------------------
+uint32 RP2350_FifoPop(void)
+{
+  uint32 Data;
+
+  while(HW_PER_SIO->FIFO_ST.bit.VLD != 1UL)
+  {
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
+
+  Data = (uint32)HW_PER_SIO->FIFO_RD.reg;
+
+  /* wake up a pusher waiting for room */
+  CORE_ARCH_SEND_EVENT_INST();
+
+  return(Data);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_IsWarmReset function
+///
+/// \descr  A warm reset (watchdog, soft reset, debugger reset) keeps the watchdog
+///         scratch registers, a power-on reset clears them.
+///
+/// \param  void
+///
+/// \return TRUE if the system was already initialized before the last reset
+//-----------------------------------------------------------------------------------------
+boolean RP2350_IsWarmReset(void)
+{
+  return((HW_PER_WATCHDOG->SCRATCH0.reg == CPU_WARM_RESET_MAGIC) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  RP2350_SetWarmResetMarker function
+///
+/// \descr  Mark the system as initialized (checked by RP2350_IsWarmReset after a reset)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void RP2350_SetWarmResetMarker(void)
+{
+  HW_PER_WATCHDOG->SCRATCH0.reg = CPU_WARM_RESET_MAGIC;
+}
@@ -29,13 +29,22 @@
 #define CPU_CORE0_ID   0UL
 #define CPU_CORE1_ID   1UL
 
-#define MULTICORE_SYNC_MASK  (uint32)((1UL << CPU_CORE0_ID) | (1UL << CPU_CORE1_ID))
+#define MULTICORE_SYNC_CORES  2UL
+
+/* Warm reset marker in the watchdog scratch register 0 (cleared by a power-on reset) */
+#define CPU_WARM_RESET_MAGIC  0x5741524DUL /* 'WARM' */
 
 //=============================================================================
 // Functions prototype
 //=============================================================================
 void RP2350_MulticoreSync(uint32 CpuId);
 boolean RP2350_StartCore1(void);
+boolean RP2350_LaunchCore1(pFunc EntryPoint);
+void RP2350_ResetCore1(void);
 void RP2350_InitCore(void);
+void RP2350_FifoPush(uint32 Data);
+uint32 RP2350_FifoPop(void);
+boolean RP2350_IsWarmReset(void);
+void RP2350_SetWarmResetMarker(void);
 
 #endif /*__RP2350_CPU_H__*/
@@ -0,0 +1,174 @@
+/******************************************************************************************
+  Filename    : Delay.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Calibrated busy-wait delays
+  
+                The ns to cycles multiplier of the usual clk_sys frequencies is taken from
+                Delay_CalibrationTable (checked on the host by
+                Tools/scripts/DelayCalibrationCheck.py), the other frequencies are
+                converted at runtime with RP2350_ClockScale.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Delay.h"
+#include "ClockDvfs.h"
+#include "Clock_Cfg.h"
+#include "InitLevel.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define DELAY_CALIBRATION_SIZE        (sizeof(Delay_CalibrationTable) / sizeof(Delay_CalibrationTable[0]))
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Delay_InitCore1(void);
+static void Delay_ClockNotifier(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile uint32 Delay_NsMul = DELAY_NS_MUL(CLOCK_SYS_FREQ_HZ);
+
+/* literal Q32 multipliers, checked against the expected cycle counts by the host script */
+static const delayCalibration_t Delay_CalibrationTable[] =
+{
+  { 12000000UL,  51539608UL   },  /* 1 us = 12 cycles, clk_sys on clk_ref (XOSC) during a PLL change */
+  { 48000000UL,  206158431UL  },  /* 1 us = 48 cycles */
+  { 100000000UL, 429496730UL  },  /* 1 us = 100 cycles */
+  { 125000000UL, 536870912UL  },  /* 1 us = 125 cycles */
+  { 133000000UL, 571230651UL  },  /* 1 us = 133 cycles */
+  { 150000000UL, 644245095UL  },  /* 1 us = 150 cycles */
+  { 200000000UL, 858993460UL  },  /* 1 us = 200 cycles */
+  { 250000000UL, 1073741824UL },  /* 1 us = 250 cycles */
+  { 300000000UL, 1288490189UL }   /* 1 us = 300 cycles */
+};
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(Delay_Init, INIT_LEVEL_POST_CLOCK, 20);
+INIT_LEVEL_REGISTER(Delay_InitCore1, INIT_LEVEL_DEFERRED, 0);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_Init function
+///
+/// \descr  Start the cycle counter of core 0 and follow the clk_sys changes.
+///         Executed at INIT_LEVEL_POST_CLOCK.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Delay_Init(void)
+{
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+
+  Delay_SetSysFreq(RP2350_ClockDvfsGetSysFreq());
+
+  (void)RP2350_ClockDvfsRegisterNotifier(&Delay_ClockNotifier);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_SetSysFreq function
+///
+/// \param  FreqHz : the clk_sys frequency
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Delay_SetSysFreq(uint32 FreqHz)
+{
+  Delay_NsMul = Delay_NsMulForFreq(FreqHz);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_NsMulForFreq function
+///
+/// \param  FreqHz : the clk_sys frequency
+///
+/// \return the ns to cycles multiplier (Q32, see DELAY_NS_MUL)
+//-----------------------------------------------------------------------------------------
+uint32 Delay_NsMulForFreq(uint32 FreqHz)
+{
+  /* FreqHz * 2^32 / 10^9 = FreqHz * 2^31 / (5 * 10^8), +1 rounds up */
+  uint32 NsMul = RP2350_ClockScale(FreqHz, 0x80000000UL, 500000000UL) + 1UL;
+
+  for(uint32 idx = 0UL; idx < DELAY_CALIBRATION_SIZE; idx++)
+  {
+    if(Delay_CalibrationTable[idx].FreqHz == FreqHz)
+    {
+      NsMul = Delay_CalibrationTable[idx].NsMul;
+      break;
+    }
+  }
+
+  return(NsMul);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_UsLong function
+///
+/// \descr  Delays of DELAY_US_INLINE_MAX us and more, waited in 1 s steps
+///
+/// \param  Us : delay in us
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Delay_UsLong(uint32 Us)
+{
+  while(Us >= DELAY_US_INLINE_MAX)
+  {
+    Delay_Ns(DELAY_US_INLINE_MAX * 1000UL);
+    Us -= DELAY_US_INLINE_MAX;
+  }
+
+  Delay_Ns(Us * 1000UL);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_InitCore1 function
+///
+/// \descr  Start the cycle counter of core 1 (each core has its own).
+///         Executed at INIT_LEVEL_DEFERRED.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Delay_InitCore1(void)
+{
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_ClockNotifier function
+///
+/// \param  Event     : pre or post change
+///         OldFreqHz : previous clk_sys
+///         NewFreqHz : new clk_sys
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Delay_ClockNotifier(clockDvfsEvent_t Event, uint32 OldFreqHz, uint32 NewFreqHz)
+{
+  (void)OldFreqHz;
+
+  if(Event == CLOCK_DVFS_POST_CHANGE)
+  {
+    Delay_SetSysFreq(NewFreqHz);
+  }
+}
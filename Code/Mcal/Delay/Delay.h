@@ -0,0 +1,129 @@
+/******************************************************************************************
+  Filename    : Delay.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Calibrated busy-wait delays header file
+  
+                The delays count clk_sys cycles with the core cycle counter (DWT CYCCNT
+                on the Cortex-M33, mcycle on Hazard3): their duration does not depend on
+                the core, the code placement (flash or SRAM) nor the loop code. The ns/us
+                conversion follows the clk_sys changes (DVFS notifier).
+  
+                Delay_Cycles and Delay_Ns are always inlined, Delay_Us is inlined below
+                DELAY_US_INLINE_MAX. The delays are minimum durations: interrupts extend them.
+  
+******************************************************************************************/
+#ifndef __DELAY_H__
+#define __DELAY_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+#include "Compiler.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* Cycles spent outside the wait loop (conversion, first and last counter read), calibrated */
+/* with the self-test (Benchmark_DelayResult.OverheadCycles) for the -O0 build              */
+#ifndef DELAY_OVERHEAD_CYCLES
+  #if defined(CORE_FAMILY_ARM)
+    #define DELAY_OVERHEAD_CYCLES   14UL
+  #else
+    #define DELAY_OVERHEAD_CYCLES   12UL
+  #endif
+#endif
+
+/* ns to cycles multiplier (Q32, rounded up): cycles = (ns * DELAY_NS_MUL(hz)) >> 32 */
+#define DELAY_NS_MUL(hz)          ((uint32)(((((uint64)(hz)) << 32) + 999999999ULL) / 1000000000ULL))
+
+/* longest Delay_Us converted inline (the ns count must fit 32 bits) */
+#define DELAY_US_INLINE_MAX       1000000UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  uint32 FreqHz;
+  uint32 NsMul;
+}delayCalibration_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+/* ns to cycles multiplier of the current clk_sys (see DELAY_NS_MUL) */
+extern volatile uint32 Delay_NsMul;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void   Delay_Init(void);
+void   Delay_SetSysFreq(uint32 FreqHz);
+uint32 Delay_NsMulForFreq(uint32 FreqHz);
+void   Delay_UsLong(uint32 Us);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_Cycles function
+///
+/// \descr  Busy-wait the given number of clk_sys cycles, call overhead included
+///
+/// \param  Cycles : delay in clk_sys cycles (at least DELAY_OVERHEAD_CYCLES)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static __force_inline void Delay_Cycles(uint32 Cycles)
+{
+  const uint32 Start = CORE_ARCH_CYCLE_COUNTER_READ();
+
+  if(Cycles > DELAY_OVERHEAD_CYCLES)
+  {
+    const uint32 Wait = Cycles - DELAY_OVERHEAD_CYCLES;
+
+    while((CORE_ARCH_CYCLE_COUNTER_READ() - Start) < Wait);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_Ns function
+///
+/// \param  Ns : delay in ns (the resolution is one clk_sys cycle)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static __force_inline void Delay_Ns(uint32 Ns)
+{
+  Delay_Cycles((uint32)(((uint64)Ns * (uint64)Delay_NsMul) >> 32));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Delay_Us function
+///
+/// \param  Us : delay in us
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static __force_inline void Delay_Us(uint32 Us)
+{
+  if(Us < DELAY_US_INLINE_MAX)
+  {
+    Delay_Ns(Us * 1000UL);
+  }
+  else
+  {
+    Delay_UsLong(Us);
+  }
+}
+
+#endif /*__DELAY_H__*/
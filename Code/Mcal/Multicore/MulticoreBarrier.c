@@ -0,0 +1,138 @@
+/******************************************************************************************
+  Filename    : MulticoreBarrier.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Reusable sense-reversing multicore barrier implementation
+  
+                All the state changes are compare-and-swap operations on the state word:
+                arrival (count + 1), completion (count 0, sense flipped) and timeout
+                withdrawal (count - 1, only while the sense is unchanged). A core which
+                gives up can therefore never leave a half-completed barrier behind.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreBarrier.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_BARRIER_SENSE     0x80000000UL
+#define MULTICORE_BARRIER_COUNT     0x7FFFFFFFUL
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBarrier_Init function
+///
+/// \param  pBarrier : the barrier (not in use)
+///         Cores    : participating cores
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreBarrier_Init(multicoreBarrier_t* pBarrier, uint32 Cores)
+{
+  pBarrier->State          = 0UL;
+  pBarrier->Cores          = Cores;
+  pBarrier->Episodes       = 0UL;
+  pBarrier->Timeouts       = 0UL;
+  pBarrier->LastSkewCycles = 0UL;
+  pBarrier->MaxSkewCycles  = 0UL;
+
+  CORE_ARCH_RELEASE_BARRIER();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBarrier_Wait function
+///
+/// \descr  Wait until all the participating cores reached the barrier. Without timeout
+///         the core sleeps in WFE / h3.block. With a timeout the core polls the cycle
+///         counter (nothing else would wake it up to check the deadline) and withdraws
+///         its arrival if the deadline passes first.
+///
+/// \param  pBarrier      : the barrier
+///         TimeoutCycles : MULTICORE_BARRIER_NO_TIMEOUT or the limit in cycles of the core
+///
+/// \return TRUE if the barrier is passed, FALSE on timeout (arrival withdrawn)
+//-----------------------------------------------------------------------------------------
+boolean MulticoreBarrier_Wait(multicoreBarrier_t* pBarrier, uint32 TimeoutCycles)
+{
+  const uint32 StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+  boolean Passed           = FALSE;
+  boolean TimedOut         = FALSE;
+  boolean Last;
+  uint32 State;
+
+  /* arrival, the last core completes the episode */
+  do
+  {
+    State = pBarrier->State;
+    Last  = (((State & MULTICORE_BARRIER_COUNT) + 1UL) >= pBarrier->Cores) ? TRUE : FALSE;
+  }
+  while(arch_atomic_cas(&pBarrier->State,
+                        State,
+                        (Last == TRUE) ? ((State ^ MULTICORE_BARRIER_SENSE) & MULTICORE_BARRIER_SENSE) : (State + 1UL)) != State);
+
+  const uint32 Sense = State & MULTICORE_BARRIER_SENSE;
+
+  if(Last == TRUE)
+  {
+    pBarrier->Episodes++;
+
+    /* the cas ends with a DMB only: complete the sense flip before the wake-up */
+    CORE_ARCH_SEND_EVENT();
+
+    Passed = TRUE;
+  }
+
+  while((Passed == FALSE) && (TimedOut == FALSE))
+  {
+    State = pBarrier->State;
+
+    if((State & MULTICORE_BARRIER_SENSE) != Sense)
+    {
+      const uint32 SkewCycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+      CORE_ARCH_ACQUIRE_BARRIER();
+
+      pBarrier->LastSkewCycles = SkewCycles;
+
+      if(SkewCycles > pBarrier->MaxSkewCycles)
+      {
+        pBarrier->MaxSkewCycles = SkewCycles;
+      }
+
+      Passed = TRUE;
+    }
+    else if(TimeoutCycles == MULTICORE_BARRIER_NO_TIMEOUT)
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+    else if((CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles) >= TimeoutCycles)
+    {
+      /* same sense: this arrival is still counted, withdraw it (fails if the episode completed) */
+      if(arch_atomic_cas(&pBarrier->State, State, State - 1UL) == State)
+      {
+        (void)arch_atomic_fetch_add(&pBarrier->Timeouts, 1UL);
+
+        TimedOut = TRUE;
+      }
+    }
+    else
+    {
+      /* poll until the deadline */
+    }
+  }
+
+  return(Passed);
+}
@@ -0,0 +1,60 @@
+/******************************************************************************************
+  Filename    : MulticoreBarrier.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Reusable sense-reversing multicore barrier header file
+  
+                One state word holds the arrival count (bits 0..30) and the sense
+                (bit 31). The last arriving core resets the count and flips the sense in
+                the same atomic operation, the other cores wait for the sense flip in
+                WFE (Cortex-M33) / h3.block (Hazard3) and are woken by SEV / h3.unblock.
+  
+                Skew: cycles waited by the core which arrived first (cycle counter of
+                that core, wake-up latency included), the last core does not wait.
+  
+******************************************************************************************/
+#ifndef __MULTICORE_BARRIER_H__
+#define __MULTICORE_BARRIER_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_BARRIER_NO_TIMEOUT   0UL
+
+/* static initializer: Cores participating cores (1 or 2) */
+#define MULTICORE_BARRIER_INIT(cores)  { 0UL, (cores), 0UL, 0UL, 0UL, 0UL }
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  volatile uint32 State;            /* bit 31: sense, bits 0..30: arrived cores */
+  uint32          Cores;
+  volatile uint32 Episodes;         /* completed barriers */
+  volatile uint32 Timeouts;
+  volatile uint32 LastSkewCycles;
+  volatile uint32 MaxSkewCycles;
+}multicoreBarrier_t;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    MulticoreBarrier_Init(multicoreBarrier_t* pBarrier, uint32 Cores);
+boolean MulticoreBarrier_Wait(multicoreBarrier_t* pBarrier, uint32 TimeoutCycles);
+
+#endif /*__MULTICORE_BARRIER_H__*/
@@ -0,0 +1,155 @@
+/******************************************************************************************
+  Filename    : MulticoreBell.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : SIO doorbells implementation
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreBell.h"
+#include "Compiler.h"
+#include "InitLevel.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_BELL_CORE_ID()    ((uint32)HW_PER_SIO->CPUID.reg)
+#define MULTICORE_BELL_MASK         ((1UL << MULTICORE_BELL_NUMBER) - 1UL)
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void MulticoreBell_InitCore1(void);
+
+/* bound to the vector table symbol (the IRQn name is taken by the IRQn_Type enum) */
+void MulticoreBell_Isr(void) __asm__("SIO_IRQ_BELL_IRQn") __time_critical;
+
+//=============================================================================
+// Globals
+//=============================================================================
+static volatile multicoreBellCallback_t MulticoreBell_Callback[MULTICORE_BELL_CORES][MULTICORE_BELL_NUMBER];
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(MulticoreBell_Init, INIT_LEVEL_POST_CLOCK, 40);
+INIT_LEVEL_REGISTER(MulticoreBell_InitCore1, INIT_LEVEL_DEFERRED, 20);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_Init function
+///
+/// \descr  Clear the doorbells of the calling core and enable its SIO_IRQ_BELL.
+///         Executed at INIT_LEVEL_POST_CLOCK (core 0) and INIT_LEVEL_DEFERRED (core 1).
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreBell_Init(void)
+{
+  HW_PER_SIO->DOORBELL_IN_CLR.reg = MULTICORE_BELL_MASK;
+
+  CORE_ARCH_ENABLE_IRQ(MULTICORE_BELL_IRQ);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_Register function
+///
+/// \param  Bell     : doorbell number
+///         Callback : called when the other core rings the doorbell (NULL: wake-up only)
+///
+/// \return TRUE if the callback is registered on the calling core
+//-----------------------------------------------------------------------------------------
+boolean MulticoreBell_Register(uint32 Bell, multicoreBellCallback_t Callback)
+{
+  boolean Registered = FALSE;
+
+  if(Bell < MULTICORE_BELL_NUMBER)
+  {
+    MulticoreBell_Callback[MULTICORE_BELL_CORE_ID()][Bell] = Callback;
+
+    Registered = TRUE;
+  }
+
+  return(Registered);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_Ring function
+///
+/// \param  Bell : doorbell number, raised on the other core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreBell_Ring(uint32 Bell)
+{
+  HW_PER_SIO->DOORBELL_OUT_SET.reg = (1UL << Bell) & MULTICORE_BELL_MASK;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_Clear function
+///
+/// \param  Bell : doorbell number, cleared on the calling core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreBell_Clear(uint32 Bell)
+{
+  HW_PER_SIO->DOORBELL_IN_CLR.reg = (1UL << Bell) & MULTICORE_BELL_MASK;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_InitCore1 function
+///
+/// \descr  Executed at INIT_LEVEL_DEFERRED (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreBell_InitCore1(void)
+{
+  MulticoreBell_Init();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreBell_Isr function (SIO_IRQ_BELL)
+///
+/// \descr  The doorbells are cleared before their callbacks: a doorbell rung again
+///         during the callback raises the interrupt again.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreBell_Isr(void)
+{
+  const uint32 Core    = MULTICORE_BELL_CORE_ID();
+  const uint32 Pending = HW_PER_SIO->DOORBELL_IN_SET.reg & MULTICORE_BELL_MASK;
+
+  HW_PER_SIO->DOORBELL_IN_CLR.reg = Pending;
+
+  for(uint32 Bell = 0UL; Bell < MULTICORE_BELL_NUMBER; Bell++)
+  {
+    const multicoreBellCallback_t Callback = MulticoreBell_Callback[Core][Bell];
+
+    if(((Pending & (1UL << Bell)) != 0UL) && (Callback != NULL))
+    {
+      Callback();
+    }
+  }
+}
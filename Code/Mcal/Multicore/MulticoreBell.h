@@ -0,0 +1,58 @@
+/******************************************************************************************
+  Filename    : MulticoreBell.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : SIO doorbells header file
+  
+                A doorbell rung by one core raises SIO_IRQ_BELL on the other core. The
+                interrupt clears the pending doorbells of the core and calls their
+                callbacks (registered per core). A doorbell without callback only wakes
+                up the core from WFI.
+  
+******************************************************************************************/
+#ifndef __MULTICORE_BELL_H__
+#define __MULTICORE_BELL_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_BELL_NUMBER     8UL
+#define MULTICORE_BELL_CORES      2UL
+
+/* SIO_IRQ_BELL line number */
+#define MULTICORE_BELL_IRQ        26UL
+
+/* doorbell assignment */
+#define MULTICORE_BELL_RING       0UL   /* ring consumer wake-up */
+#define MULTICORE_BELL_RPC        1UL   /* remote procedure call posted */
+#define MULTICORE_BELL_RPC_DONE   2UL   /* synchronous call completed (caller wake-up) */
+
+//=============================================================================
+// Types definition
+//=============================================================================
+/* called from SIO_IRQ_BELL of the core which registered it */
+typedef void (*multicoreBellCallback_t)(void);
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    MulticoreBell_Init(void);
+boolean MulticoreBell_Register(uint32 Bell, multicoreBellCallback_t Callback);
+void    MulticoreBell_Ring(uint32 Bell);
+void    MulticoreBell_Clear(uint32 Bell);
+
+#endif /*__MULTICORE_BELL_H__*/
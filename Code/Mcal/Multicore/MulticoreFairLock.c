@@ -0,0 +1,336 @@
+/******************************************************************************************
+  Filename    : MulticoreFairLock.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Fair inter-core locks implementation (ticket lock and MCS queue lock)
+  
+                The read-modify-write operations are the arch_atomic_* functions of
+                util.s (ldaex/stlex on the Cortex-M33, AMOs and lr.w/sc.w on Hazard3),
+                they order the memory accesses around them. The release is a plain
+                store of the owner after a release barrier, followed by an event: the
+                waiters sleep in WFE / h3.block between two polls.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreFairLock.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_FAIR_LOCK_CORE_ID()    ((uint32)HW_PER_SIO->CPUID.reg)
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void MulticoreFairLock_Record(multicoreLockStats_t* pStats, uint32 Spins, uint32 StartCycles);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_Init function
+///
+/// \param  pLock  : the lock
+///         pStats : statistics (NULL: none)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreTicketLock_Init(multicoreTicketLock_t* pLock, multicoreLockStats_t* pStats)
+{
+  pLock->Next   = 0UL;
+  pLock->Owner  = 0UL;
+  pLock->pStats = pStats;
+
+  CORE_ARCH_RELEASE_BARRIER();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_Lock function
+///
+/// \param  pLock : the lock
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreTicketLock_Lock(multicoreTicketLock_t* pLock)
+{
+  const uint32 StartCycles = (pLock->pStats != NULL) ? CORE_ARCH_CYCLE_COUNTER_READ() : 0UL;
+  const uint32 Ticket      = arch_atomic_fetch_add(&pLock->Next, 1UL);
+  uint32 Spins             = 0UL;
+
+  while(pLock->Owner != Ticket)
+  {
+    Spins++;
+
+    CORE_ARCH_WAIT_FOR_EVENT();
+  }
+
+  CORE_ARCH_ACQUIRE_BARRIER();
+
+  MulticoreFairLock_Record(pLock->pStats, Spins, StartCycles);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_TryLock function
+///
+/// \param  pLock : the lock
+///
+/// \return TRUE if the lock is acquired, FALSE if it is taken (no ticket taken)
+//-----------------------------------------------------------------------------------------
+boolean MulticoreTicketLock_TryLock(multicoreTicketLock_t* pLock)
+{
+  const uint32 Owner = pLock->Owner;
+  boolean Acquired   = FALSE;
+
+  /* free: the next ticket is the owner one */
+  if(arch_atomic_cas(&pLock->Next, Owner, Owner + 1UL) == Owner)
+  {
+    MulticoreFairLock_Record(pLock->pStats, 0UL, (pLock->pStats != NULL) ? CORE_ARCH_CYCLE_COUNTER_READ() : 0UL);
+
+    Acquired = TRUE;
+  }
+
+  return(Acquired);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_Unlock function
+///
+/// \param  pLock : the lock (held by the caller)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreTicketLock_Unlock(multicoreTicketLock_t* pLock)
+{
+  CORE_ARCH_RELEASE_BARRIER();
+
+  /* only the owner writes Owner */
+  pLock->Owner = pLock->Owner + 1UL;
+
+  CORE_ARCH_SEND_EVENT();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_LockIrq function
+///
+/// \param  pLock : the lock
+///
+/// \return the interrupt state for MulticoreTicketLock_UnlockIrq
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreTicketLock_LockIrq(multicoreTicketLock_t* pLock)
+{
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+  MulticoreTicketLock_Lock(pLock);
+
+  return(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreTicketLock_UnlockIrq function
+///
+/// \param  pLock    : the lock (held by the caller)
+///         IrqState : returned by MulticoreTicketLock_LockIrq
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreTicketLock_UnlockIrq(multicoreTicketLock_t* pLock, uint32 IrqState)
+{
+  MulticoreTicketLock_Unlock(pLock);
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_Init function
+///
+/// \param  pLock  : the lock
+///         pStats : statistics (NULL: none)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreMcsLock_Init(multicoreMcsLock_t* pLock, multicoreLockStats_t* pStats)
+{
+  pLock->Tail   = 0UL;
+  pLock->pStats = pStats;
+
+  for(uint32 Core = 0UL; Core < MULTICORE_FAIR_LOCK_CORES; Core++)
+  {
+    pLock->Node[Core].Next   = 0UL;
+    pLock->Node[Core].Locked = 0UL;
+  }
+
+  CORE_ARCH_RELEASE_BARRIER();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_Lock function
+///
+/// \descr  Queue the node of the calling core behind the tail, then wait until the
+///         predecessor hands the lock over (poll of the own node only, sleeping in
+///         between)
+///
+/// \param  pLock : the lock
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreMcsLock_Lock(multicoreMcsLock_t* pLock)
+{
+  const uint32 StartCycles  = (pLock->pStats != NULL) ? CORE_ARCH_CYCLE_COUNTER_READ() : 0UL;
+  multicoreMcsNode_t* pNode = &pLock->Node[MULTICORE_FAIR_LOCK_CORE_ID()];
+  uint32 Spins              = 0UL;
+
+  pNode->Next   = 0UL;
+  pNode->Locked = 1UL;
+
+  /* the swap orders the node initialization before the enqueue */
+  const uint32 Prev = arch_atomic_swap(&pLock->Tail, (uint32)pNode);
+
+  if(Prev != 0UL)
+  {
+    ((multicoreMcsNode_t*)Prev)->Next = (uint32)pNode;
+
+    /* wake up a predecessor waiting in unlock for the link */
+    CORE_ARCH_SEND_EVENT();
+
+    while(pNode->Locked != 0UL)
+    {
+      Spins++;
+
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+  }
+
+  MulticoreFairLock_Record(pLock->pStats, Spins, StartCycles);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_TryLock function
+///
+/// \param  pLock : the lock
+///
+/// \return TRUE if the lock is acquired, FALSE if it is taken (not queued)
+//-----------------------------------------------------------------------------------------
+boolean MulticoreMcsLock_TryLock(multicoreMcsLock_t* pLock)
+{
+  multicoreMcsNode_t* pNode = &pLock->Node[MULTICORE_FAIR_LOCK_CORE_ID()];
+  boolean Acquired          = FALSE;
+
+  pNode->Next   = 0UL;
+  pNode->Locked = 0UL;
+
+  if(arch_atomic_cas(&pLock->Tail, 0UL, (uint32)pNode) == 0UL)
+  {
+    MulticoreFairLock_Record(pLock->pStats, 0UL, (pLock->pStats != NULL) ? CORE_ARCH_CYCLE_COUNTER_READ() : 0UL);
+
+    Acquired = TRUE;
+  }
+
+  return(Acquired);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_Unlock function
+///
+/// \descr  Without successor the tail is reset to free. A successor which swapped the
+///         tail but has not linked its node yet is waited for, then handed the lock.
+///
+/// \param  pLock : the lock (held by the caller)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreMcsLock_Unlock(multicoreMcsLock_t* pLock)
+{
+  multicoreMcsNode_t* pNode = &pLock->Node[MULTICORE_FAIR_LOCK_CORE_ID()];
+  boolean Released          = FALSE;
+
+  if(pNode->Next == 0UL)
+  {
+    /* the cas releases the accesses of the critical section */
+    Released = (arch_atomic_cas(&pLock->Tail, (uint32)pNode, 0UL) == (uint32)pNode) ? TRUE : FALSE;
+
+    while((Released == FALSE) && (pNode->Next == 0UL))
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+  }
+
+  if(Released == FALSE)
+  {
+    CORE_ARCH_RELEASE_BARRIER();
+
+    ((multicoreMcsNode_t*)pNode->Next)->Locked = 0UL;
+
+    CORE_ARCH_SEND_EVENT();
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_LockIrq function
+///
+/// \param  pLock : the lock
+///
+/// \return the interrupt state for MulticoreMcsLock_UnlockIrq
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreMcsLock_LockIrq(multicoreMcsLock_t* pLock)
+{
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+  MulticoreMcsLock_Lock(pLock);
+
+  return(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreMcsLock_UnlockIrq function
+///
+/// \param  pLock    : the lock (held by the caller)
+///         IrqState : returned by MulticoreMcsLock_LockIrq
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreMcsLock_UnlockIrq(multicoreMcsLock_t* pLock, uint32 IrqState)
+{
+  MulticoreMcsLock_Unlock(pLock);
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreFairLock_Record function
+///
+/// \descr  Update the statistics of a lock (called by the new owner)
+///
+/// \param  pStats      : statistics (NULL: none)
+///         Spins       : polls of the taken lock
+///         StartCycles : cycle counter at the lock call
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreFairLock_Record(multicoreLockStats_t* pStats, uint32 Spins, uint32 StartCycles)
+{
+  if(pStats != NULL)
+  {
+    const uint32 WaitCycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+    pStats->Acquisitions++;
+    pStats->Spins += Spins;
+
+    if(WaitCycles > pStats->MaxWaitCycles)
+    {
+      pStats->MaxWaitCycles = WaitCycles;
+    }
+  }
+}
@@ -0,0 +1,95 @@
+/******************************************************************************************
+  Filename    : MulticoreFairLock.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Fair inter-core locks header file (ticket lock and MCS queue lock)
+  
+                Both locks grant the lock in the order of arrival: a core looping on
+                lock / unlock cannot starve the other one (unlike arch_spin_lock).
+                Ticket lock: one fetch-and-add to take a ticket, the waiters poll the
+                owner counter. MCS lock: the waiters queue their node with one swap and
+                each one polls its own node (no shared polled word).
+  
+                The MCS lock holds one node per core: like the ticket lock it is taken
+                by Lock / Unlock only. An interrupt handler taking a lock also held by
+                the thread of its core needs the Irq variants in the thread.
+  
+                Statistics (optional, pStats != NULL): updated by the owner inside the
+                lock, readable at any time. The wait is measured with the cycle counter
+                of the acquiring core.
+  
+******************************************************************************************/
+#ifndef __MULTICORE_FAIR_LOCK_H__
+#define __MULTICORE_FAIR_LOCK_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_FAIR_LOCK_CORES   2UL
+
+/* static initializers, pStats: multicoreLockStats_t* or NULL */
+#define MULTICORE_TICKET_LOCK_INIT(pstats)   { 0UL, 0UL, (pstats) }
+#define MULTICORE_MCS_LOCK_INIT(pstats)      { 0UL, { { 0UL, 0UL }, { 0UL, 0UL } }, (pstats) }
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  volatile uint32 Acquisitions;
+  volatile uint32 Spins;          /* polls of a taken lock, all acquisitions */
+  volatile uint32 MaxWaitCycles;  /* longest lock call */
+}multicoreLockStats_t;
+
+typedef struct
+{
+  volatile uint32       Next;     /* next ticket to take */
+  volatile uint32       Owner;    /* ticket holding the lock */
+  multicoreLockStats_t* pStats;
+}multicoreTicketLock_t;
+
+typedef struct
+{
+  volatile uint32 Next;           /* multicoreMcsNode_t* of the next waiter, 0: none */
+  volatile uint32 Locked;         /* 1: waiting for the predecessor */
+}multicoreMcsNode_t;
+
+typedef struct
+{
+  volatile uint32       Tail;     /* multicoreMcsNode_t* of the last waiter, 0: free */
+  multicoreMcsNode_t    Node[MULTICORE_FAIR_LOCK_CORES];
+  multicoreLockStats_t* pStats;
+}multicoreMcsLock_t;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    MulticoreTicketLock_Init(multicoreTicketLock_t* pLock, multicoreLockStats_t* pStats);
+void    MulticoreTicketLock_Lock(multicoreTicketLock_t* pLock);
+boolean MulticoreTicketLock_TryLock(multicoreTicketLock_t* pLock);
+void    MulticoreTicketLock_Unlock(multicoreTicketLock_t* pLock);
+uint32  MulticoreTicketLock_LockIrq(multicoreTicketLock_t* pLock);
+void    MulticoreTicketLock_UnlockIrq(multicoreTicketLock_t* pLock, uint32 IrqState);
+
+void    MulticoreMcsLock_Init(multicoreMcsLock_t* pLock, multicoreLockStats_t* pStats);
+void    MulticoreMcsLock_Lock(multicoreMcsLock_t* pLock);
+boolean MulticoreMcsLock_TryLock(multicoreMcsLock_t* pLock);
+void    MulticoreMcsLock_Unlock(multicoreMcsLock_t* pLock);
+uint32  MulticoreMcsLock_LockIrq(multicoreMcsLock_t* pLock);
+void    MulticoreMcsLock_UnlockIrq(multicoreMcsLock_t* pLock, uint32 IrqState);
+
+#endif /*__MULTICORE_FAIR_LOCK_H__*/
@@ -0,0 +1,232 @@
+/******************************************************************************************
+  Filename    : MulticoreLock.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core spinlocks implementation
+  
+                SIO spinlock n: a read returns (1 << n) and claims it if it was free, 0
+                if it is taken; any write releases it. The SIO is not ordered with the
+                SRAM accesses: a barrier follows the claim and precedes the release.
+                A core waiting for a taken lock sleeps in WFE / h3.block, the unlock
+                sends the event.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreLock.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* SPINLOCK0 to SPINLOCK31 are consecutive SIO registers */
+#define MULTICORE_LOCK_SIO_REG(id)   ((&HW_PER_SIO->SPINLOCK0.reg)[(id)])
+
+//=============================================================================
+// Globals
+//=============================================================================
+/* SIO spinlocks in use (bit n: SPINLOCKn), protected by MulticoreLock_ClaimLock */
+static uint32 MulticoreLock_SioClaimed;
+static uint32 MulticoreLock_ClaimLock;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_Init function
+///
+/// \descr  Allocate the lock (a free SIO spinlock for the SIO backend), free state
+///
+/// \param  pLock   : the lock
+///         Backend : MULTICORE_LOCK_BACKEND_SIO or MULTICORE_LOCK_BACKEND_EXCLUSIVE
+///
+/// \return TRUE if the lock is initialized, FALSE if all the SIO spinlocks are in use
+//-----------------------------------------------------------------------------------------
+boolean MulticoreLock_Init(multicoreLock_t* pLock, multicoreLockBackend_t Backend)
+{
+  boolean Initialized = FALSE;
+
+  if(pLock != NULL)
+  {
+    pLock->Backend = Backend;
+    pLock->Id      = MULTICORE_LOCK_SIO_NUMBER;
+    pLock->Word    = 0UL;
+
+    if(Backend == MULTICORE_LOCK_BACKEND_SIO)
+    {
+      const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+      arch_spin_lock(&MulticoreLock_ClaimLock);
+
+      for(uint32 Id = 0UL; (Id < MULTICORE_LOCK_SIO_NUMBER) && (pLock->Id == MULTICORE_LOCK_SIO_NUMBER); Id++)
+      {
+        if((MulticoreLock_SioClaimed & (1UL << Id)) == 0UL)
+        {
+          MulticoreLock_SioClaimed |= (1UL << Id);
+
+          pLock->Id = Id;
+        }
+      }
+
+      arch_spin_unlock(&MulticoreLock_ClaimLock);
+
+      CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+      if(pLock->Id < MULTICORE_LOCK_SIO_NUMBER)
+      {
+        MULTICORE_LOCK_SIO_REG(pLock->Id) = 0UL;
+
+        Initialized = TRUE;
+      }
+    }
+    else
+    {
+      Initialized = TRUE;
+    }
+
+    CORE_ARCH_RELEASE_BARRIER();
+  }
+
+  return(Initialized);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_Deinit function
+///
+/// \param  pLock : the lock (free, not used anymore)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreLock_Deinit(multicoreLock_t* pLock)
+{
+  if((pLock->Backend == MULTICORE_LOCK_BACKEND_SIO) && (pLock->Id < MULTICORE_LOCK_SIO_NUMBER))
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    arch_spin_lock(&MulticoreLock_ClaimLock);
+
+    MulticoreLock_SioClaimed &= ~(1UL << pLock->Id);
+
+    arch_spin_unlock(&MulticoreLock_ClaimLock);
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+    pLock->Id = MULTICORE_LOCK_SIO_NUMBER;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_Lock function
+///
+/// \param  pLock : the lock
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreLock_Lock(multicoreLock_t* pLock)
+{
+  if(pLock->Backend == MULTICORE_LOCK_BACKEND_SIO)
+  {
+    /* taken: sleep until an unlock sends its event */
+    while(MULTICORE_LOCK_SIO_REG(pLock->Id) == 0UL)
+    {
+      CORE_ARCH_WAIT_FOR_EVENT();
+    }
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+  }
+  else
+  {
+    arch_spin_lock(&pLock->Word);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_TryLock function
+///
+/// \param  pLock : the lock
+///
+/// \return TRUE if the lock is acquired, FALSE if it is taken
+//-----------------------------------------------------------------------------------------
+boolean MulticoreLock_TryLock(multicoreLock_t* pLock)
+{
+  boolean Acquired;
+
+  if(pLock->Backend == MULTICORE_LOCK_BACKEND_SIO)
+  {
+    Acquired = (MULTICORE_LOCK_SIO_REG(pLock->Id) != 0UL) ? TRUE : FALSE;
+
+    CORE_ARCH_ACQUIRE_BARRIER();
+  }
+  else
+  {
+    Acquired = (arch_spin_trylock(&pLock->Word) != 0UL) ? TRUE : FALSE;
+  }
+
+  return(Acquired);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_Unlock function
+///
+/// \param  pLock : the lock (held by the caller)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreLock_Unlock(multicoreLock_t* pLock)
+{
+  if(pLock->Backend == MULTICORE_LOCK_BACKEND_SIO)
+  {
+    CORE_ARCH_RELEASE_BARRIER();
+
+    MULTICORE_LOCK_SIO_REG(pLock->Id) = 0UL;
+
+    CORE_ARCH_SEND_EVENT();
+  }
+  else
+  {
+    arch_spin_unlock(&pLock->Word);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_LockIrq function
+///
+/// \descr  Mask the interrupts of the calling core then acquire the lock: an interrupt
+///         handler of this core taking the same lock cannot deadlock the thread.
+///
+/// \param  pLock : the lock
+///
+/// \return the interrupt state for MulticoreLock_UnlockIrq
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreLock_LockIrq(multicoreLock_t* pLock)
+{
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+  MulticoreLock_Lock(pLock);
+
+  return(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreLock_UnlockIrq function
+///
+/// \param  pLock    : the lock (held by the caller)
+///         IrqState : returned by MulticoreLock_LockIrq
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreLock_UnlockIrq(multicoreLock_t* pLock, uint32 IrqState)
+{
+  MulticoreLock_Unlock(pLock);
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+}
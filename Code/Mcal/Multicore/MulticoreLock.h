@@ -0,0 +1,71 @@
+/******************************************************************************************
+  Filename    : MulticoreLock.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core spinlocks header file
+  
+                A lock is backed either by one of the 32 SIO hardware spinlocks (a read
+                claims it, a write releases it) or by a lock word with exclusive access
+                (arch_spin_lock: ldaex/strex on the Cortex-M33, lr.w/sc.w on Hazard3).
+                The backend is chosen per lock, Benchmark_Lock compares both.
+  
+                The exclusive backend on the Cortex-M33 needs ACTLR.EXTEXCLALL (set in
+                RP2350_InitCore and on core 1 entry), the SIO backend needs nothing.
+                RP2350-E2: on the A2 stepping, writes to some other SIO registers also
+                release SIO spinlocks, prefer the exclusive backend where it matters.
+  
+                The plain variants are for the thread context (or an interrupt handler
+                when the thread never takes the same lock), the Irq variants mask the
+                interrupts of the calling core while the lock is held.
+  
+******************************************************************************************/
+#ifndef __MULTICORE_LOCK_H__
+#define __MULTICORE_LOCK_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_LOCK_SIO_NUMBER   32UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef enum
+{
+  MULTICORE_LOCK_BACKEND_SIO = 0,
+  MULTICORE_LOCK_BACKEND_EXCLUSIVE
+}multicoreLockBackend_t;
+
+typedef struct
+{
+  multicoreLockBackend_t Backend;
+  uint32                 Id;      /* SIO spinlock number (SIO backend) */
+  uint32                 Word;    /* lock word, 0: free (exclusive backend) */
+}multicoreLock_t;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+boolean MulticoreLock_Init(multicoreLock_t* pLock, multicoreLockBackend_t Backend);
+void    MulticoreLock_Deinit(multicoreLock_t* pLock);
+void    MulticoreLock_Lock(multicoreLock_t* pLock);
+boolean MulticoreLock_TryLock(multicoreLock_t* pLock);
+void    MulticoreLock_Unlock(multicoreLock_t* pLock);
+uint32  MulticoreLock_LockIrq(multicoreLock_t* pLock);
+void    MulticoreLock_UnlockIrq(multicoreLock_t* pLock, uint32 IrqState);
+
+#endif /*__MULTICORE_LOCK_H__*/
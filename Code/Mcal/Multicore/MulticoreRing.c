@@ -0,0 +1,314 @@
+/******************************************************************************************
+  Filename    : MulticoreRing.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Lock-free single-producer / single-consumer inter-core ring implementation
+  
+                Producer: copy the elements, release barrier, store Head.
+                Consumer: load Head, acquire barrier, copy the elements, release barrier,
+                store Tail (the slots are handed back once the copy is complete).
+  
+                Lost wake-up: the consumer stores ConsumerWaiting then loads Head, the
+                producer stores Head then loads ConsumerWaiting, both with a full barrier
+                in between: at least one of them sees the other one's store.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreRing.h"
+#include "MulticoreBell.h"
+#include "core_arch.h"
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void MulticoreRing_Copy(uint32* pDst, const uint32* pSrc, uint32 Words);
+static void MulticoreRing_Publish(multicoreRing_t* pRing, uint32 Head);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Init function
+///
+/// \descr  Runtime alternative to MULTICORE_RING_INIT, called before both cores use the ring
+///
+/// \param  pRing       : the ring
+///         pStorage    : Elements * ElementSize bytes, word aligned
+///         ElementSize : bytes, multiple of 4
+///         Elements    : power of 2
+///         Bell        : doorbell used to wake the consumer
+///
+/// \return TRUE if the ring is initialized
+//-----------------------------------------------------------------------------------------
+boolean MulticoreRing_Init(multicoreRing_t* pRing, void* pStorage, uint32 ElementSize, uint32 Elements, uint32 Bell)
+{
+  boolean Initialized = FALSE;
+
+  if((pRing != NULL) && (pStorage != NULL)                          &&
+     (ElementSize != 0UL) && ((ElementSize & 3UL) == 0UL)           &&
+     (Elements != 0UL) && ((Elements & (Elements - 1UL)) == 0UL)    &&
+     (Bell < MULTICORE_BELL_NUMBER))
+  {
+    pRing->Head            = 0UL;
+    pRing->Tail            = 0UL;
+    pRing->ConsumerWaiting = 0UL;
+    pRing->Mask            = Elements - 1UL;
+    pRing->ElementSize     = ElementSize;
+    pRing->pStorage        = (uint8*)pStorage;
+    pRing->Bell            = Bell;
+    pRing->Wakeups         = 0UL;
+    pRing->Sleeps          = 0UL;
+
+    CORE_ARCH_RELEASE_BARRIER();
+
+    Initialized = TRUE;
+  }
+
+  return(Initialized);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Count function
+///
+/// \param  pRing : the ring
+///
+/// \return the number of elements in the ring
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreRing_Count(const multicoreRing_t* pRing)
+{
+  return(pRing->Head - pRing->Tail);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Push function (producer)
+///
+/// \descr  The elements are published together (one barrier and one doorbell at most)
+///
+/// \param  pRing     : the ring
+///         pElements : Count consecutive elements, word aligned
+///         Count     : elements to write
+///
+/// \return the number of elements written (less than Count if the ring is full)
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreRing_Push(multicoreRing_t* pRing, const void* pElements, uint32 Count)
+{
+  const uint32 Head  = pRing->Head;
+  const uint32 Free  = (pRing->Mask + 1UL) - (Head - pRing->Tail);
+  const uint32 Words = pRing->ElementSize / sizeof(uint32);
+  const uint32* pSrc = (const uint32*)pElements;
+
+  Count = (Count > Free) ? Free : Count;
+
+  /* the Tail load above is ordered before the slot writes (the consumer released them) */
+  CORE_ARCH_ACQUIRE_BARRIER();
+
+  for(uint32 idx = 0UL; idx < Count; idx++)
+  {
+    MulticoreRing_Copy((uint32*)&pRing->pStorage[((Head + idx) & pRing->Mask) * pRing->ElementSize], pSrc, Words);
+
+    pSrc += Words;
+  }
+
+  if(Count != 0UL)
+  {
+    MulticoreRing_Publish(pRing, Head + Count);
+  }
+
+  return(Count);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Pop function (consumer)
+///
+/// \param  pRing     : the ring
+///         pElements : room for Count elements, word aligned
+///         Count     : elements to read
+///
+/// \return the number of elements read (less than Count if the ring runs empty)
+//-----------------------------------------------------------------------------------------
+uint32 MulticoreRing_Pop(multicoreRing_t* pRing, void* pElements, uint32 Count)
+{
+  const uint32 Tail  = pRing->Tail;
+  const uint32 Used  = pRing->Head - Tail;
+  const uint32 Words = pRing->ElementSize / sizeof(uint32);
+  uint32* pDst       = (uint32*)pElements;
+
+  Count = (Count > Used) ? Used : Count;
+
+  CORE_ARCH_ACQUIRE_BARRIER();
+
+  for(uint32 idx = 0UL; idx < Count; idx++)
+  {
+    MulticoreRing_Copy(pDst, (const uint32*)&pRing->pStorage[((Tail + idx) & pRing->Mask) * pRing->ElementSize], Words);
+
+    pDst += Words;
+  }
+
+  if(Count != 0UL)
+  {
+    CORE_ARCH_RELEASE_BARRIER();
+
+    pRing->Tail = Tail + Count;
+  }
+
+  return(Count);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_WriteBegin function (producer, zero-copy)
+///
+/// \param  pRing : the ring
+///
+/// \return the next free slot (to fill then commit), NULL if the ring is full
+//-----------------------------------------------------------------------------------------
+void* MulticoreRing_WriteBegin(multicoreRing_t* pRing)
+{
+  const uint32 Head = pRing->Head;
+  void* pSlot       = NULL;
+
+  if((Head - pRing->Tail) <= pRing->Mask)
+  {
+    CORE_ARCH_ACQUIRE_BARRIER();
+
+    pSlot = &pRing->pStorage[(Head & pRing->Mask) * pRing->ElementSize];
+  }
+
+  return(pSlot);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_WriteCommit function (producer, zero-copy)
+///
+/// \param  pRing : the ring (slot returned by MulticoreRing_WriteBegin filled)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreRing_WriteCommit(multicoreRing_t* pRing)
+{
+  MulticoreRing_Publish(pRing, pRing->Head + 1UL);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_ReadBegin function (consumer, zero-copy)
+///
+/// \param  pRing : the ring
+///
+/// \return the oldest element (valid until MulticoreRing_ReadEnd), NULL if the ring is empty
+//-----------------------------------------------------------------------------------------
+const void* MulticoreRing_ReadBegin(multicoreRing_t* pRing)
+{
+  const uint32 Tail = pRing->Tail;
+  const void* pSlot = NULL;
+
+  if(pRing->Head != Tail)
+  {
+    CORE_ARCH_ACQUIRE_BARRIER();
+
+    pSlot = &pRing->pStorage[(Tail & pRing->Mask) * pRing->ElementSize];
+  }
+
+  return(pSlot);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_ReadEnd function (consumer, zero-copy)
+///
+/// \param  pRing : the ring (element returned by MulticoreRing_ReadBegin processed)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreRing_ReadEnd(multicoreRing_t* pRing)
+{
+  CORE_ARCH_RELEASE_BARRIER();
+
+  pRing->Tail = pRing->Tail + 1UL;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_WaitData function (consumer)
+///
+/// \descr  Sleep until the ring holds at least one element. The check and the WFI
+///         run with the interrupts masked: a doorbell rung in between stays pending
+///         and ends the WFI.
+///
+/// \param  pRing : the ring
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreRing_WaitData(multicoreRing_t* pRing)
+{
+  while(pRing->Head == pRing->Tail)
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    pRing->ConsumerWaiting = 1UL;
+
+    CORE_ARCH_MEMORY_BARRIER();
+
+    if(pRing->Head == pRing->Tail)
+    {
+      pRing->Sleeps++;
+
+      CORE_ARCH_WAIT_FOR_INTERRUPT();
+    }
+
+    pRing->ConsumerWaiting = 0UL;
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+  }
+
+  CORE_ARCH_ACQUIRE_BARRIER();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Copy function
+///
+/// \param  pDst  : destination
+///         pSrc  : source
+///         Words : words to copy
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreRing_Copy(uint32* pDst, const uint32* pSrc, uint32 Words)
+{
+  for(uint32 idx = 0UL; idx < Words; idx++)
+  {
+    pDst[idx] = pSrc[idx];
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRing_Publish function
+///
+/// \descr  Make the written elements visible and wake the consumer if it sleeps
+///
+/// \param  pRing : the ring
+///         Head  : new Head
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreRing_Publish(multicoreRing_t* pRing, uint32 Head)
+{
+  CORE_ARCH_RELEASE_BARRIER();
+
+  pRing->Head = Head;
+
+  /* the Head store is ordered before the ConsumerWaiting load */
+  CORE_ARCH_MEMORY_BARRIER();
+
+  if(pRing->ConsumerWaiting != 0UL)
+  {
+    pRing->Wakeups++;
+
+    MulticoreBell_Ring(pRing->Bell);
+  }
+}
@@ -0,0 +1,73 @@
+/******************************************************************************************
+  Filename    : MulticoreRing.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Lock-free single-producer / single-consumer inter-core ring header file
+  
+                The ring holds fixed-size elements in shared SRAM. The producer core only
+                writes Head, the consumer core only writes Tail (free-running counters):
+                no lock is needed. The element copies are ordered with the indexes by
+                release/acquire barriers (DMB on the Cortex-M33, fence on Hazard3).
+  
+                A consumer waiting on an empty ring sleeps in WFI, the producer rings the
+                ring doorbell only when the consumer announced it is waiting. The ring is
+                for two different cores, the consumer core should keep its interrupts
+                enabled (the doorbell interrupt clears the wake-up request).
+  
+******************************************************************************************/
+#ifndef __MULTICORE_RING_H__
+#define __MULTICORE_RING_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+#include "Compiler.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* static initializer: Elements must be a power of 2, ElementSize a multiple of 4 bytes */
+#define MULTICORE_RING_INIT(storage, elementsize, elements, bell)   \
+  { 0UL, 0UL, 0UL, ((elements) - 1UL), (elementsize), (uint8*)(storage), (bell), 0UL, 0UL }
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  volatile uint32  Head;             /* elements written (producer only) */
+  volatile uint32  Tail;             /* elements read (consumer only) */
+  volatile uint32  ConsumerWaiting;  /* 1: the consumer sleeps on the empty ring */
+  uint32           Mask;             /* elements - 1 */
+  uint32           ElementSize;      /* bytes */
+  uint8*           pStorage;
+  uint32           Bell;             /* doorbell rung to wake the consumer */
+  volatile uint32  Wakeups;          /* doorbells rung by the producer */
+  volatile uint32  Sleeps;           /* consumer sleeps */
+}multicoreRing_t;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+boolean     MulticoreRing_Init(multicoreRing_t* pRing, void* pStorage, uint32 ElementSize, uint32 Elements, uint32 Bell);
+uint32      MulticoreRing_Count(const multicoreRing_t* pRing);
+uint32      MulticoreRing_Push(multicoreRing_t* pRing, const void* pElements, uint32 Count);
+uint32      MulticoreRing_Pop(multicoreRing_t* pRing, void* pElements, uint32 Count);
+void*       MulticoreRing_WriteBegin(multicoreRing_t* pRing);
+void        MulticoreRing_WriteCommit(multicoreRing_t* pRing);
+/* in RAM: the zero-copy consumer side runs in MulticoreRpc_Serve (__time_critical) */
+const void* MulticoreRing_ReadBegin(multicoreRing_t* pRing) __time_critical;
+void        MulticoreRing_ReadEnd(multicoreRing_t* pRing) __time_critical;
+void        MulticoreRing_WaitData(multicoreRing_t* pRing);
+
+#endif /*__MULTICORE_RING_H__*/
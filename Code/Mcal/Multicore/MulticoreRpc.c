@@ -0,0 +1,300 @@
+/******************************************************************************************
+  Filename    : MulticoreRpc.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core remote procedure calls implementation
+  
+                Each core owns one call queue (SPSC ring): the other core is the only
+                producer (the push runs with its interrupts masked, the thread and the
+                interrupts of one core never push concurrently), the RPC doorbell callback
+                of the owner core is the only consumer.
+  
+                A synchronous call carries the completion of the calling core: the other
+                core writes the result, release barrier, sets Done and rings the
+                completion doorbell.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "MulticoreRpc.h"
+#include "MulticoreBell.h"
+#include "MulticoreRing.h"
+#include "Compiler.h"
+#include "InitLevel.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_RPC_CORE_ID()    ((uint32)HW_PER_SIO->CPUID.reg)
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  volatile uint32 Busy;     /* 1: a synchronous call of this core is outstanding */
+  volatile uint32 Done;     /* set by the other core once Result is written */
+  volatile uint32 Result;
+}multicoreRpcCompletion_t;
+
+/* call descriptor queued in shared SRAM (12 bytes) */
+typedef struct
+{
+  multicoreRpcFunc_t        Func;
+  uint32                    Arg;
+  multicoreRpcCompletion_t* pCompletion;   /* NULL: fire-and-forget */
+}multicoreRpcMsg_t;
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void    MulticoreRpc_InitCore1(void);
+static boolean MulticoreRpc_Send(const multicoreRpcMsg_t* pMsg);
+static void    MulticoreRpc_Serve(void) __time_critical;
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile multicoreRpcStats_t MulticoreRpc_Stats[MULTICORE_RPC_CORES];
+
+static multicoreRpcMsg_t MulticoreRpc_Storage[MULTICORE_RPC_CORES][MULTICORE_RPC_QUEUE_SIZE];
+
+/* queue of the executing core, doorbell unused (the consumer never sleeps on it) */
+static multicoreRing_t MulticoreRpc_Queue[MULTICORE_RPC_CORES] =
+{
+  MULTICORE_RING_INIT(MulticoreRpc_Storage[0], sizeof(multicoreRpcMsg_t), MULTICORE_RPC_QUEUE_SIZE, MULTICORE_BELL_RPC),
+  MULTICORE_RING_INIT(MulticoreRpc_Storage[1], sizeof(multicoreRpcMsg_t), MULTICORE_RPC_QUEUE_SIZE, MULTICORE_BELL_RPC)
+};
+
+/* completion of the calling core */
+static multicoreRpcCompletion_t MulticoreRpc_Completion[MULTICORE_RPC_CORES];
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(MulticoreRpc_Init, INIT_LEVEL_POST_CLOCK, 50);
+INIT_LEVEL_REGISTER(MulticoreRpc_InitCore1, INIT_LEVEL_DEFERRED, 30);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_Init function
+///
+/// \descr  Serve the calls of the other core on the calling core (after MulticoreBell_Init).
+///         Executed at INIT_LEVEL_POST_CLOCK (core 0) and INIT_LEVEL_DEFERRED (core 1).
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void MulticoreRpc_Init(void)
+{
+  const uint32 Core = MULTICORE_RPC_CORE_ID();
+
+  MulticoreRpc_Stats[Core].MinCycles = 0xFFFFFFFFUL;
+
+  (void)MulticoreBell_Register(MULTICORE_BELL_RPC, &MulticoreRpc_Serve);
+
+  /* completion doorbell: wake-up only */
+  (void)MulticoreBell_Register(MULTICORE_BELL_RPC_DONE, NULL);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_Call function (synchronous, thread context)
+///
+/// \descr  Run Func(Arg) on the other core and wait for its result. The calling core
+///         sleeps in WFI with its interrupts served between two checks, so a call of
+///         the other core to this one is served meanwhile.
+///         Precondition: both cores have their interrupts enabled (PRIMASK / mstatus.MIE
+///         and SIO_IRQ_BELL). A target core with masked interrupts never serves the
+///         call and the caller waits forever, a caller with masked interrupts does not
+///         serve the calls to itself: two such calls deadlock.
+///
+/// \param  Func    : function executed on the other core
+///         Arg     : its argument
+///         pResult : its return value (may be NULL)
+///
+/// \return TRUE if the call completed, FALSE if the queue is full or a call is outstanding
+//-----------------------------------------------------------------------------------------
+boolean MulticoreRpc_Call(multicoreRpcFunc_t Func, uint32 Arg, uint32* pResult)
+{
+  const uint32 Core                     = MULTICORE_RPC_CORE_ID();
+  multicoreRpcCompletion_t* pCompletion = &MulticoreRpc_Completion[Core];
+  boolean Completed                     = FALSE;
+  uint32 IrqState                       = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+  const boolean Free                    = (pCompletion->Busy == 0UL) ? TRUE : FALSE;
+
+  pCompletion->Busy = 1UL;
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+  if((Func != NULL) && (Free == TRUE))
+  {
+    const multicoreRpcMsg_t Msg = { Func, Arg, pCompletion };
+    const uint32 StartCycles    = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    pCompletion->Done = 0UL;
+
+    if(MulticoreRpc_Send(&Msg) == TRUE)
+    {
+      while(pCompletion->Done == 0UL)
+      {
+        IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+        if(pCompletion->Done == 0UL)
+        {
+          CORE_ARCH_WAIT_FOR_INTERRUPT();
+        }
+
+        CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+      }
+
+      CORE_ARCH_ACQUIRE_BARRIER();
+
+      const uint32 Cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+
+      if(pResult != NULL)
+      {
+        *pResult = pCompletion->Result;
+      }
+
+      MulticoreRpc_Stats[Core].Calls++;
+      MulticoreRpc_Stats[Core].SumCycles += Cycles;
+      MulticoreRpc_Stats[Core].MinCycles  = (Cycles < MulticoreRpc_Stats[Core].MinCycles) ? Cycles : MulticoreRpc_Stats[Core].MinCycles;
+      MulticoreRpc_Stats[Core].MaxCycles  = (Cycles > MulticoreRpc_Stats[Core].MaxCycles) ? Cycles : MulticoreRpc_Stats[Core].MaxCycles;
+
+      Completed = TRUE;
+    }
+  }
+
+  if(Free == TRUE)
+  {
+    pCompletion->Busy = 0UL;
+  }
+
+  return(Completed);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_Post function (fire-and-forget, thread or interrupt context)
+///
+/// \param  Func : function executed on the other core (its return value is dropped)
+///         Arg  : its argument
+///
+/// \return TRUE if the call is queued, FALSE if the queue of the other core is full
+//-----------------------------------------------------------------------------------------
+boolean MulticoreRpc_Post(multicoreRpcFunc_t Func, uint32 Arg)
+{
+  const multicoreRpcMsg_t Msg = { Func, Arg, NULL };
+  boolean Posted              = FALSE;
+
+  if(Func != NULL)
+  {
+    Posted = MulticoreRpc_Send(&Msg);
+
+    if(Posted == TRUE)
+    {
+      MulticoreRpc_Stats[MULTICORE_RPC_CORE_ID()].Posts++;
+    }
+  }
+
+  return(Posted);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_InitCore1 function
+///
+/// \descr  Executed at INIT_LEVEL_DEFERRED (core 1)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreRpc_InitCore1(void)
+{
+  MulticoreRpc_Init();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_Send function
+///
+/// \descr  Queue the descriptor for the other core and ring its RPC doorbell
+///
+/// \param  pMsg : call descriptor
+///
+/// \return TRUE if the descriptor is queued
+//-----------------------------------------------------------------------------------------
+static boolean MulticoreRpc_Send(const multicoreRpcMsg_t* pMsg)
+{
+  const uint32 Core     = MULTICORE_RPC_CORE_ID();
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+  boolean Sent          = FALSE;
+
+  if(MulticoreRing_Push(&MulticoreRpc_Queue[Core ^ 1UL], pMsg, 1UL) == 1UL)
+  {
+    MulticoreBell_Ring(MULTICORE_BELL_RPC);
+
+    Sent = TRUE;
+  }
+  else
+  {
+    MulticoreRpc_Stats[Core].QueueFull++;
+  }
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+  return(Sent);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  MulticoreRpc_Serve function (MULTICORE_BELL_RPC callback, SIO_IRQ_BELL)
+///
+/// \descr  Execute all the calls queued by the other core. The slot is released before
+///         the call, so the other core can queue again while the function runs.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void MulticoreRpc_Serve(void)
+{
+  const uint32 Core       = MULTICORE_RPC_CORE_ID();
+  multicoreRing_t* pQueue = &MulticoreRpc_Queue[Core];
+  const multicoreRpcMsg_t* pSlot;
+
+  while((pSlot = (const multicoreRpcMsg_t*)MulticoreRing_ReadBegin(pQueue)) != NULL)
+  {
+    const multicoreRpcMsg_t Msg = *pSlot;
+
+    MulticoreRing_ReadEnd(pQueue);
+
+    const uint32 Result = Msg.Func(Msg.Arg);
+
+    MulticoreRpc_Stats[Core].Served++;
+
+    if(Msg.pCompletion != NULL)
+    {
+      Msg.pCompletion->Result = Result;
+
+      CORE_ARCH_RELEASE_BARRIER();
+
+      Msg.pCompletion->Done = 1UL;
+
+      /* Done is visible before the wake-up (the caller clears the doorbell on wake-up) */
+      CORE_ARCH_MEMORY_BARRIER();
+
+      MulticoreBell_Ring(MULTICORE_BELL_RPC_DONE);
+    }
+  }
+}
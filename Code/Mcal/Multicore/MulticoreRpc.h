@@ -0,0 +1,69 @@
+/******************************************************************************************
+  Filename    : MulticoreRpc.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Inter-core remote procedure calls header file
+  
+                A call descriptor (function, argument, completion) is queued in the ring
+                of the other core and signaled with the RPC doorbell. The other core runs
+                the function from its SIO_IRQ_BELL interrupt, so it must have its
+                interrupts enabled: a synchronous call to a core running with masked
+                interrupts (e.g. core 0 during the benchmarks) never completes.
+                Synchronous calls sleep until the completion doorbell; they are for the
+                thread context with the interrupts enabled (one outstanding call per core).
+  
+******************************************************************************************/
+#ifndef __MULTICORE_RPC_H__
+#define __MULTICORE_RPC_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define MULTICORE_RPC_QUEUE_SIZE   16UL   /* calls waiting per core, power of 2 */
+#define MULTICORE_RPC_CORES        2UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+/* executed on the other core (SIO_IRQ_BELL context) */
+typedef uint32 (*multicoreRpcFunc_t)(uint32 Arg);
+
+typedef struct
+{
+  uint32 Calls;         /* synchronous calls */
+  uint32 Posts;         /* fire-and-forget calls */
+  uint32 QueueFull;     /* calls rejected (queue of the other core full) */
+  uint32 Served;        /* calls executed for the other core */
+  uint32 MinCycles;     /* synchronous round-trip */
+  uint32 MaxCycles;
+  uint32 SumCycles;     /* average: SumCycles / Calls */
+}multicoreRpcStats_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+/* per calling core */
+extern volatile multicoreRpcStats_t MulticoreRpc_Stats[MULTICORE_RPC_CORES];
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    MulticoreRpc_Init(void);
+boolean MulticoreRpc_Call(multicoreRpcFunc_t Func, uint32 Arg, uint32* pResult);
+boolean MulticoreRpc_Post(multicoreRpcFunc_t Func, uint32 Arg);
+
+#endif /*__MULTICORE_RPC_H__*/
@@ -55,21 +55,6 @@ void SysTickTimer_Start(uint32 timeout)
   pSTK_CTRL->bits.u1ENABLE = SYS_TICK_ENABLE_TIMER;
 }
 
-//-----------------------------------------------------------------------------
-/// \brief
-///
-/// \descr
-///
-/// \param
-///
-/// \return
-//-----------------------------------------------------------------------------
-void SysTickTimer_Reload(uint32 timeout)
-{
-  pSTK_VAL->u32Register    = 0;
-  pSTK_LOAD->u32Register   = timeout;
-}
-
 //-----------------------------------------------------------------------------
 /// \brief
 ///
@@ -82,4 +67,4 @@ void SysTickTimer_Reload(uint32 timeout)
 void SysTickTimer_Stop(void)
 {
   pSTK_CTRL->bits.u1ENABLE = 0U;
-}
\ No newline at end of file
+}
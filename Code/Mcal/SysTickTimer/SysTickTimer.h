@@ -19,6 +19,7 @@
 #define __SYSTICK_TIMER_H__
 
 #include "Platform_Types.h"
+#include "Compiler.h"
 
 //=========================================================================================
 // Types definition
@@ -87,9 +88,7 @@ typedef union
 #define pSTK_VAL    ((volatile stStkVal* const)  (SYS_TICK_BASE_REG + 0x08))
 #define pSTK_CALIB  ((volatile stStkCalib* const)(SYS_TICK_BASE_REG + 0x0C))
 
-#define CPU_FREQ_MHZ      150U
-#define SYS_TICK_MS(x)    ((uint32)(CPU_FREQ_MHZ * x * 1000UL) - 1UL)
-#define SYS_TICK_US(x)    ((uint32)(CPU_FREQ_MHZ * x) - 1UL)
+#define SYS_TICK_RELOAD_MAX   0x00FFFFFFUL
 
 #define SYS_TICK_CLKSRC_PROCESSOR_CLOCK           1U
 #define SYS_TICK_CLKSRC_EXTERNAL_REFERENCE_CLOCK  0U
@@ -102,6 +101,5 @@ typedef union
 void SysTickTimer_Init(void);
 void SysTickTimer_Start(uint32 timeout);
 void SysTickTimer_Stop(void);
-void SysTickTimer_Reload(uint32 timeout);
 
 #endif /*__SYSTICK_TIMER_H__*/
@@ -0,0 +1,421 @@
+/******************************************************************************************
+  Filename    : Timebase.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : 64-bit microsecond timebase and alarm multiplexer for RP2350
+  
+                The timebase is the TIMER0 64-bit counter (1 us tick from clk_ref),
+                it is shared by both cores and does not depend on clk_sys (DVFS).
+  
+                Any number of one-shot or periodic alarms is multiplexed on the four
+                TIMER0 hardware alarms: each hardware alarm serves one queue sorted by
+                deadline and is always armed with the earliest one. A queue is used by
+                one core only (the core that called Timebase_EnableQueue), e.g. queues
+                0/1 for core 0 and 2/3 for core 1, the callbacks run in its interrupt.
+  
+                The periodic alarms are re-armed from their previous deadline, not from
+                the interrupt time, so the latency never accumulates (drift-free).
+                TIMER1 is left free for the application.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Timebase.h"
+#include "Clock.h"
+#include "Compiler.h"
+#include "InitLevel.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* RP2350 atomic register access aliases (bits written as 1 are set / cleared) */
+#define TIMEBASE_REG_SET(reg)      (*(volatile uint32*)((uint32)&(reg) + 0x2000UL))
+#define TIMEBASE_REG_CLR(reg)      (*(volatile uint32*)((uint32)&(reg) + 0x3000UL))
+
+#define TIMEBASE_QUEUE_MASK(q)     (1UL << (q))
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void Timebase_Insert(timebaseAlarm_t* pAlarm) __time_critical;
+static void Timebase_Remove(timebaseAlarm_t* pAlarm);
+static void Timebase_ProgramAlarm(uint32 Queue) __time_critical;
+static void Timebase_ServiceQueue(uint32 Queue) __time_critical;
+
+/* bound to the vector table symbols (the IRQn names are taken by the IRQn_Type enum) */
+void Timebase_Alarm0Isr(void) __asm__("TIMER0_IRQ_0_IRQn") __time_critical;
+void Timebase_Alarm1Isr(void) __asm__("TIMER0_IRQ_1_IRQn") __time_critical;
+void Timebase_Alarm2Isr(void) __asm__("TIMER0_IRQ_2_IRQn") __time_critical;
+void Timebase_Alarm3Isr(void) __asm__("TIMER0_IRQ_3_IRQn") __time_critical;
+
+//=============================================================================
+// Globals
+//=============================================================================
+static timebaseAlarm_t* Timebase_QueueHead[TIMEBASE_QUEUE_NUMBER];
+
+static volatile uint32* const Timebase_AlarmReg[TIMEBASE_QUEUE_NUMBER] =
+{
+  (volatile uint32*)&HW_PER_TIMER0->ALARM0.reg,
+  (volatile uint32*)&HW_PER_TIMER0->ALARM1.reg,
+  (volatile uint32*)&HW_PER_TIMER0->ALARM2.reg,
+  (volatile uint32*)&HW_PER_TIMER0->ALARM3.reg
+};
+
+//=============================================================================
+// Init levels
+//=============================================================================
+INIT_LEVEL_REGISTER(Timebase_Init, INIT_LEVEL_POST_CLOCK, 10);
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_Init function
+///
+/// \descr  Start the TIMER0 tick (if needed) and reset the hardware alarms and the queues.
+///         Executed at INIT_LEVEL_POST_CLOCK.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Timebase_Init(void)
+{
+  RP2350_ClockTickStart();
+
+  /* disarm the hardware alarms and drop their pending interrupts */
+  HW_PER_TIMER0->ARMED.reg = 0x0FUL;
+  HW_PER_TIMER0->INTE.reg  = 0UL;
+  HW_PER_TIMER0->INTF.reg  = 0UL;
+  HW_PER_TIMER0->INTR.reg  = 0x0FUL;
+
+  for(uint32 Queue = 0UL; Queue < TIMEBASE_QUEUE_NUMBER; Queue++)
+  {
+    Timebase_QueueHead[Queue] = NULL;
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_GetUs function
+///
+/// \descr  Read the 64-bit counter without latching (safe on both cores at the same time)
+///
+/// \param  void
+///
+/// \return the time since the TIMER0 start (us)
+//-----------------------------------------------------------------------------------------
+uint64 Timebase_GetUs(void)
+{
+  uint32 High;
+  uint32 Low;
+  uint32 HighAgain = (uint32)HW_PER_TIMER0->TIMERAWH.reg;
+
+  /* retry if the low word wrapped between the two reads of the high word */
+  do
+  {
+    High      = HighAgain;
+    Low       = (uint32)HW_PER_TIMER0->TIMERAWL.reg;
+    HighAgain = (uint32)HW_PER_TIMER0->TIMERAWH.reg;
+  } while(High != HighAgain);
+
+  return(((uint64)High << 32) | (uint64)Low);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_GetUs32 function
+///
+/// \param  void
+///
+/// \return the low 32 bits of the timebase (us), wraps after 71 minutes
+//-----------------------------------------------------------------------------------------
+uint32 Timebase_GetUs32(void)
+{
+  return((uint32)HW_PER_TIMER0->TIMERAWL.reg);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_EnableQueue function
+///
+/// \descr  Route the hardware alarm of the queue to the calling core. The callbacks of
+///         the queue run on this core once its interrupts are globally enabled.
+///
+/// \param  Queue : 0..TIMEBASE_QUEUE_NUMBER-1
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Timebase_EnableQueue(uint32 Queue)
+{
+  if(Queue < TIMEBASE_QUEUE_NUMBER)
+  {
+    TIMEBASE_REG_SET(HW_PER_TIMER0->INTE.reg) = TIMEBASE_QUEUE_MASK(Queue);
+
+    CORE_ARCH_ENABLE_IRQ(TIMEBASE_IRQ_BASE + Queue);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_AlarmStart function
+///
+/// \descr  (Re)start an alarm. A running alarm is moved to its new deadline.
+///         A deadline in the past expires immediately.
+///
+/// \param  pAlarm     : alarm object, must stay valid while the alarm is active
+///         Queue      : hardware alarm serving it (owned by the calling core)
+///         DeadlineUs : absolute expiry time (see Timebase_GetUs)
+///         PeriodUs   : 0 for a one-shot alarm, else the period
+///         Callback   : called from the interrupt of the queue
+///         pArg       : callback argument
+///
+/// \return FALSE if the parameters are invalid
+//-----------------------------------------------------------------------------------------
+boolean Timebase_AlarmStart(timebaseAlarm_t* pAlarm, uint32 Queue, uint64 DeadlineUs, uint32 PeriodUs, timebaseCallback_t Callback, void* pArg)
+{
+  boolean Status = FALSE;
+
+  if((pAlarm != NULL) && (Callback != NULL) && (Queue < TIMEBASE_QUEUE_NUMBER))
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    if(TRUE == pAlarm->Active)
+    {
+      Timebase_Remove(pAlarm);
+      Timebase_ProgramAlarm(pAlarm->Queue);
+    }
+
+    pAlarm->DeadlineUs = DeadlineUs;
+    pAlarm->PeriodUs   = PeriodUs;
+    pAlarm->Queue      = Queue;
+    pAlarm->Overruns   = 0UL;
+    pAlarm->Callback   = Callback;
+    pAlarm->pArg       = pArg;
+
+    Timebase_Insert(pAlarm);
+
+    /* only a new earliest deadline needs the hardware alarm to move */
+    if(Timebase_QueueHead[Queue] == pAlarm)
+    {
+      Timebase_ProgramAlarm(Queue);
+    }
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+    Status = TRUE;
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_AlarmCancel function
+///
+/// \param  pAlarm : alarm to stop (nothing is done if it is not active)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Timebase_AlarmCancel(timebaseAlarm_t* pAlarm)
+{
+  if(pAlarm != NULL)
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    if(TRUE == pAlarm->Active)
+    {
+      const boolean WasHead = (Timebase_QueueHead[pAlarm->Queue] == pAlarm) ? TRUE : FALSE;
+
+      Timebase_Remove(pAlarm);
+
+      if(TRUE == WasHead)
+      {
+        Timebase_ProgramAlarm(pAlarm->Queue);
+      }
+    }
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_WaitUntil function
+///
+/// \descr  Busy-wait until the deadline (1 us resolution)
+///
+/// \param  DeadlineUs : absolute time (see Timebase_GetUs)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Timebase_WaitUntil(uint64 DeadlineUs)
+{
+  while(Timebase_GetUs() < DeadlineUs);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_Insert function
+///
+/// \descr  Insert an alarm in its queue, after the alarms with the same deadline
+///         (called with the interrupts disabled)
+///
+/// \param  pAlarm : alarm to insert
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Timebase_Insert(timebaseAlarm_t* pAlarm)
+{
+  timebaseAlarm_t** ppLink = &Timebase_QueueHead[pAlarm->Queue];
+
+  while((*ppLink != NULL) && ((*ppLink)->DeadlineUs <= pAlarm->DeadlineUs))
+  {
+    ppLink = &(*ppLink)->pNext;
+  }
+
+  pAlarm->pNext  = *ppLink;
+  *ppLink        = pAlarm;
+  pAlarm->Active = TRUE;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_Remove function
+///
+/// \descr  Unlink an active alarm from its queue (called with the interrupts disabled)
+///
+/// \param  pAlarm : alarm to remove
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Timebase_Remove(timebaseAlarm_t* pAlarm)
+{
+  timebaseAlarm_t** ppLink = &Timebase_QueueHead[pAlarm->Queue];
+
+  while((*ppLink != NULL) && (*ppLink != pAlarm))
+  {
+    ppLink = &(*ppLink)->pNext;
+  }
+
+  if(*ppLink == pAlarm)
+  {
+    *ppLink = pAlarm->pNext;
+  }
+
+  pAlarm->pNext  = NULL;
+  pAlarm->Active = FALSE;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_ProgramAlarm function
+///
+/// \descr  Arm the hardware alarm of the queue with its earliest deadline. The alarm only
+///         compares the low 32 bits: a deadline beyond TIMEBASE_ALARM_MAX_SPAN is reached
+///         through intermediate wake-ups. A deadline already passed (or passed while
+///         arming) is forced through INTF, the hardware alarm would miss it otherwise.
+///
+/// \param  Queue : queue to program (called with the interrupts disabled)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Timebase_ProgramAlarm(uint32 Queue)
+{
+  const uint32 Mask              = TIMEBASE_QUEUE_MASK(Queue);
+  const timebaseAlarm_t* pHead   = Timebase_QueueHead[Queue];
+
+  if(pHead == NULL)
+  {
+    /* writing 1 disarms */
+    HW_PER_TIMER0->ARMED.reg = Mask;
+  }
+  else
+  {
+    const uint64 Now = Timebase_GetUs();
+
+    if(pHead->DeadlineUs <= Now)
+    {
+      TIMEBASE_REG_SET(HW_PER_TIMER0->INTF.reg) = Mask;
+    }
+    else
+    {
+      const uint64 Delta  = pHead->DeadlineUs - Now;
+      const uint32 Target = (Delta > (uint64)TIMEBASE_ALARM_MAX_SPAN) ? ((uint32)Now + TIMEBASE_ALARM_MAX_SPAN)
+                                                                       : (uint32)pHead->DeadlineUs;
+
+      /* writing the alarm register arms it */
+      *Timebase_AlarmReg[Queue] = Target;
+
+      if(((sint32)(Timebase_GetUs32() - Target) >= 0) && ((HW_PER_TIMER0->ARMED.reg & Mask) != 0UL))
+      {
+        HW_PER_TIMER0->ARMED.reg = Mask;
+        TIMEBASE_REG_SET(HW_PER_TIMER0->INTF.reg) = Mask;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_ServiceQueue function
+///
+/// \descr  Expire the due alarms of the queue, re-arm the periodic ones from their
+///         previous deadline then program the hardware alarm with the next deadline.
+///
+/// \param  Queue : queue of the interrupt
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Timebase_ServiceQueue(uint32 Queue)
+{
+  const uint32 Mask = TIMEBASE_QUEUE_MASK(Queue);
+
+  /* acknowledge the alarm (INTR is write-1-to-clear) and a forced interrupt */
+  TIMEBASE_REG_CLR(HW_PER_TIMER0->INTF.reg) = Mask;
+  HW_PER_TIMER0->INTR.reg = Mask;
+
+  uint64 Now = Timebase_GetUs();
+
+  while((Timebase_QueueHead[Queue] != NULL) && (Timebase_QueueHead[Queue]->DeadlineUs <= Now))
+  {
+    timebaseAlarm_t* pAlarm = Timebase_QueueHead[Queue];
+
+    Timebase_QueueHead[Queue] = pAlarm->pNext;
+    pAlarm->pNext             = NULL;
+    pAlarm->Active            = FALSE;
+
+    if(pAlarm->PeriodUs != 0UL)
+    {
+      pAlarm->DeadlineUs += pAlarm->PeriodUs;
+
+      /* keep the phase: skip the periods already missed */
+      while(pAlarm->DeadlineUs <= Now)
+      {
+        pAlarm->DeadlineUs += pAlarm->PeriodUs;
+        pAlarm->Overruns++;
+      }
+
+      Timebase_Insert(pAlarm);
+    }
+
+    /* the callback may start or cancel any alarm of the queue, itself included */
+    pAlarm->Callback(pAlarm->pArg);
+
+    Now = Timebase_GetUs();
+  }
+
+  Timebase_ProgramAlarm(Queue);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Timebase_AlarmnIsr functions (TIMER0_IRQ_n, one per queue)
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Timebase_Alarm0Isr(void) { Timebase_ServiceQueue(0UL); }
+void Timebase_Alarm1Isr(void) { Timebase_ServiceQueue(1UL); }
+void Timebase_Alarm2Isr(void) { Timebase_ServiceQueue(2UL); }
+void Timebase_Alarm3Isr(void) { Timebase_ServiceQueue(3UL); }
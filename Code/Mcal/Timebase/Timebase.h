@@ -0,0 +1,67 @@
+/******************************************************************************************
+  Filename    : Timebase.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : 64-bit microsecond timebase and alarm multiplexer header file for RP2350
+  
+******************************************************************************************/
+#ifndef __RP2350_TIMEBASE_H__
+#define __RP2350_TIMEBASE_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+#include "Compiler.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* one alarm queue per TIMER0 hardware alarm (TIMER0_IRQ_0..3) */
+#define TIMEBASE_QUEUE_NUMBER     4UL
+
+/* the hardware alarms compare 32 bits: farther deadlines are reached in steps */
+#define TIMEBASE_ALARM_MAX_SPAN   0x7FFFFFFFUL
+
+/* TIMER0_IRQ_0 line number (TIMER0_IRQ_n = TIMEBASE_IRQ_BASE + n) */
+#define TIMEBASE_IRQ_BASE         0UL
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef void (*timebaseCallback_t)(void* pArg);
+
+typedef struct timebaseAlarm
+{
+  struct timebaseAlarm* pNext;       /* queue link, owned by the timebase */
+  uint64                DeadlineUs;  /* absolute expiry time */
+  uint32                PeriodUs;    /* 0: one-shot, else re-armed at DeadlineUs + PeriodUs */
+  uint32                Queue;       /* hardware alarm serving this alarm */
+  uint32                Overruns;    /* periods skipped because the callback ran late */
+  timebaseCallback_t    Callback;    /* called from the TIMER0_IRQ_n interrupt */
+  void*                 pArg;
+  boolean               Active;
+}timebaseAlarm_t;
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    Timebase_Init(void);
+/* in RAM: the alarm ISRs and the queue service (__time_critical) read the counter */
+uint64  Timebase_GetUs(void) __time_critical;
+uint32  Timebase_GetUs32(void) __time_critical;
+void    Timebase_EnableQueue(uint32 Queue);
+boolean Timebase_AlarmStart(timebaseAlarm_t* pAlarm, uint32 Queue, uint64 DeadlineUs, uint32 PeriodUs, timebaseCallback_t Callback, void* pArg);
+void    Timebase_AlarmCancel(timebaseAlarm_t* pAlarm);
+void    Timebase_WaitUntil(uint64 DeadlineUs);
+
+#endif /*__RP2350_TIMEBASE_H__*/
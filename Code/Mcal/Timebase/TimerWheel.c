@@ -0,0 +1,736 @@
+/******************************************************************************************
+  Filename    : TimerWheel.c
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Hierarchical timing wheel
+  
+                One wheel per core, advanced every TIMER_WHEEL_TICK_US by a periodic
+                timebase alarm. The wheel has TIMER_WHEEL_LEVELS levels of
+                TIMER_WHEEL_SLOTS slots, a timer is linked in the slot covering its
+                expiry tick: start, stop and expiry are O(1), the timers of an upper
+                level slot are cascaded to the lower levels once every 64^level ticks.
+  
+                A timer belongs to the wheel of the core that started it and must be
+                stopped / restarted from that core. Expired timers call back either
+                from the tick interrupt (TIMER_WHEEL_CONTEXT_ISR) or are queued for
+                TimerWheel_RunDeferred (TIMER_WHEEL_CONTEXT_DEFERRED).
+  
+                Tickless idle: TimerWheel_Idle moves the tick alarm to the first tick
+                with work (expiry or cascade) and sleeps until an interrupt. The
+                skipped ticks are empty, the wheel jumps over them on wake-up.
+  
+******************************************************************************************/
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "TimerWheel.h"
+#include "Timebase.h"
+#include "core_arch.h"
+#include "RP2350.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+#define TIMER_WHEEL_SLOT_MASK       (TIMER_WHEEL_SLOTS - 1UL)
+
+#define TIMER_WHEEL_STATE_IDLE      0U
+#define TIMER_WHEEL_STATE_PENDING   1U   /* linked in a slot */
+#define TIMER_WHEEL_STATE_EXPIRED   2U   /* linked in the deferred list */
+
+#define TIMER_WHEEL_CORE_ID()       ((uint32)HW_PER_SIO->CPUID.reg)
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct
+{
+  uint32            Now;            /* next tick to process */
+  uint32            Active;         /* timers linked in the slots */
+  uint32            TickOverruns;   /* tick alarm overruns already accounted */
+  uint32            SkippedTicks;   /* empty ticks jumped over by the next tick alarm */
+  boolean           Ready;
+  timebaseAlarm_t   TickAlarm;
+  timerWheelLink_t  Deferred;
+  timerWheelLink_t  Slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+}timerWheel_t;
+
+//=============================================================================
+// Prototypes
+//=============================================================================
+static void TimerWheel_ListInit(timerWheelLink_t* pHead);
+static void TimerWheel_ListAppend(timerWheelLink_t* pHead, timerWheelLink_t* pLink);
+static void TimerWheel_ListUnlink(timerWheelLink_t* pLink);
+static void TimerWheel_ListMove(timerWheelLink_t* pFrom, timerWheelLink_t* pTo);
+static void TimerWheel_Add(timerWheel_t* pWheel, timerWheelTimer_t* pTimer);
+static void TimerWheel_Detach(timerWheel_t* pWheel, timerWheelTimer_t* pTimer);
+static void TimerWheel_Cascade(timerWheel_t* pWheel, uint32 Level, uint32 Index);
+static void TimerWheel_Advance(timerWheel_t* pWheel);
+static void TimerWheel_TickCallback(void* pArg);
+static uint32 TimerWheel_FreeTicks(const timerWheel_t* pWheel);
+static void TimerWheel_IdleWake(timerWheel_t* pWheel, uint64 TickDeadlineUs, uint32 Skip);
+
+//=============================================================================
+// Globals
+//=============================================================================
+volatile timerWheelIdleStats_t TimerWheel_IdleStats[TIMER_WHEEL_CORES];
+
+static timerWheel_t TimerWheel_Wheel[TIMER_WHEEL_CORES];
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Init function
+///
+/// \descr  Initialize the wheel of the calling core (once, before its first timer) and
+///         start its tick on the given timebase queue.
+///
+/// \param  Queue : timebase queue of the tick (owned by this core) or TIMER_WHEEL_NO_TICK
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void TimerWheel_Init(uint32 Queue)
+{
+  timerWheel_t* pWheel = &TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()];
+
+  Timebase_AlarmCancel(&pWheel->TickAlarm);
+
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+  for(uint32 Level = 0UL; Level < TIMER_WHEEL_LEVELS; Level++)
+  {
+    for(uint32 Index = 0UL; Index < TIMER_WHEEL_SLOTS; Index++)
+    {
+      TimerWheel_ListInit(&pWheel->Slot[Level][Index]);
+    }
+  }
+
+  TimerWheel_ListInit(&pWheel->Deferred);
+
+  pWheel->Now          = 0UL;
+  pWheel->Active       = 0UL;
+  pWheel->TickOverruns = 0UL;
+  pWheel->SkippedTicks = 0UL;
+  pWheel->Ready        = TRUE;
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+  if(Queue != TIMER_WHEEL_NO_TICK)
+  {
+    Timebase_EnableQueue(Queue);
+
+    (void)Timebase_AlarmStart(&pWheel->TickAlarm,
+                              Queue,
+                              Timebase_GetUs() + TIMER_WHEEL_TICK_US,
+                              TIMER_WHEEL_TICK_US,
+                              &TimerWheel_TickCallback,
+                              (void*)pWheel);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Start function
+///
+/// \descr  (Re)start a timer on the wheel of the calling core. The first period is
+///         partial: the timer expires on the Ticks-th tick from now.
+///
+/// \param  pTimer      : timer, must stay valid while active
+///         Ticks       : first timeout in ticks (limited to TIMER_WHEEL_MAX_TICKS)
+///         PeriodTicks : 0 for a one-shot timer, else the reload (drift-free)
+///         Callback    : expiry callback
+///         Context     : TIMER_WHEEL_CONTEXT_ISR or TIMER_WHEEL_CONTEXT_DEFERRED
+///
+/// \return FALSE if the wheel is not initialized or the parameters are invalid
+//-----------------------------------------------------------------------------------------
+boolean TimerWheel_Start(timerWheelTimer_t* pTimer, uint32 Ticks, uint32 PeriodTicks, timerWheelCallback_t Callback, uint32 Context)
+{
+  const uint32 Core    = TIMER_WHEEL_CORE_ID();
+  timerWheel_t* pWheel = &TimerWheel_Wheel[Core];
+  boolean Status       = FALSE;
+
+  if((pTimer != NULL) && (Callback != NULL) && (TRUE == pWheel->Ready) && (Context <= TIMER_WHEEL_CONTEXT_DEFERRED))
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    TimerWheel_Detach(pWheel, pTimer);
+
+    pTimer->Expiry   = pWheel->Now + ((Ticks > TIMER_WHEEL_MAX_TICKS) ? TIMER_WHEEL_MAX_TICKS : Ticks);
+    pTimer->Period   = (PeriodTicks > TIMER_WHEEL_MAX_TICKS) ? TIMER_WHEEL_MAX_TICKS : PeriodTicks;
+    pTimer->Callback = Callback;
+    pTimer->Core     = (uint8)Core;
+    pTimer->Context  = (uint8)Context;
+
+    TimerWheel_Add(pWheel, pTimer);
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+    Status = TRUE;
+  }
+
+  return(Status);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Stop function
+///
+/// \descr  Stop a timer, also drops a pending deferred expiry
+///
+/// \param  pTimer : timer (from the core that started it)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void TimerWheel_Stop(timerWheelTimer_t* pTimer)
+{
+  if(pTimer != NULL)
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    TimerWheel_Detach(&TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()], pTimer);
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_IsActive function
+///
+/// \param  pTimer : timer
+///
+/// \return TRUE if the timer runs or waits for its deferred callback
+//-----------------------------------------------------------------------------------------
+boolean TimerWheel_IsActive(const timerWheelTimer_t* pTimer)
+{
+  return(((pTimer != NULL) && (pTimer->State != TIMER_WHEEL_STATE_IDLE)) ? TRUE : FALSE);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_GetTicks function
+///
+/// \param  void
+///
+/// \return the ticks processed by the wheel of the calling core
+//-----------------------------------------------------------------------------------------
+uint32 TimerWheel_GetTicks(void)
+{
+  return(TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()].Now);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Process function
+///
+/// \descr  Advance the wheel of the calling core, expiring the due timers. Called by the
+///         tick alarm, or by the application for a wheel without tick.
+///
+/// \param  Ticks : number of ticks elapsed
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void TimerWheel_Process(uint32 Ticks)
+{
+  timerWheel_t* pWheel = &TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()];
+
+  if(TRUE == pWheel->Ready)
+  {
+    for(uint32 Tick = 0UL; Tick < Ticks; Tick++)
+    {
+      TimerWheel_Advance(pWheel);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_RunDeferred function
+///
+/// \descr  Call back the expired TIMER_WHEEL_CONTEXT_DEFERRED timers of the calling core
+///         (e.g. from the main loop). The periodic ones are re-armed from their expiry.
+///
+/// \param  void
+///
+/// \return the number of callbacks executed
+//-----------------------------------------------------------------------------------------
+uint32 TimerWheel_RunDeferred(void)
+{
+  timerWheel_t* pWheel = &TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()];
+  uint32 Count         = 0UL;
+  boolean Empty        = (TRUE == pWheel->Ready) ? FALSE : TRUE;
+
+  while(FALSE == Empty)
+  {
+    timerWheelTimer_t* pTimer = NULL;
+
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    if(pWheel->Deferred.pNext != &pWheel->Deferred)
+    {
+      pTimer = (timerWheelTimer_t*)pWheel->Deferred.pNext;
+
+      TimerWheel_ListUnlink(&pTimer->Link);
+      pTimer->State = TIMER_WHEEL_STATE_IDLE;
+
+      if(pTimer->Period != 0UL)
+      {
+        pTimer->Expiry += pTimer->Period;
+        TimerWheel_Add(pWheel, pTimer);
+      }
+    }
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+    if(pTimer != NULL)
+    {
+      pTimer->Callback(pTimer);
+      Count++;
+    }
+    else
+    {
+      Empty = TRUE;
+    }
+  }
+
+  return(Count);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_IdleTicks function
+///
+/// \param  void
+///
+/// \return the number of ticks without work on the wheel of the calling core
+//-----------------------------------------------------------------------------------------
+uint32 TimerWheel_IdleTicks(void)
+{
+  const timerWheel_t* pWheel = &TimerWheel_Wheel[TIMER_WHEEL_CORE_ID()];
+  uint32 Ticks               = 0UL;
+
+  if(TRUE == pWheel->Ready)
+  {
+    const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+    Ticks = TimerWheel_FreeTicks(pWheel);
+
+    CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+  }
+
+  return(Ticks);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Idle function
+///
+/// \descr  Tickless idle of the calling core, called from its idle loop. The tick alarm
+///         is moved to the first tick with work then the core sleeps until an interrupt.
+///         On wake-up the wheel is compensated for the skipped ticks and the pending
+///         interrupts are served before returning. Without ticks to skip (work on the
+///         next tick, wheel not started) the core still sleeps until the next interrupt,
+///         only pending deferred timers return at once.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void TimerWheel_Idle(void)
+{
+  const uint32 Core    = TIMER_WHEEL_CORE_ID();
+  timerWheel_t* pWheel = &TimerWheel_Wheel[Core];
+
+  const uint32 IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+
+  if(pWheel->Deferred.pNext == &pWheel->Deferred)
+  {
+    uint32 Skip = ((TRUE == pWheel->Ready) && (TRUE == pWheel->TickAlarm.Active)) ? TimerWheel_FreeTicks(pWheel) : 0UL;
+
+    Skip = (Skip > TIMER_WHEEL_IDLE_MAX_TICKS) ? TIMER_WHEEL_IDLE_MAX_TICKS : Skip;
+
+    if(Skip != 0UL)
+    {
+      /* the tick alarm deadline is the one of the next tick to process (Now) */
+      const uint64 TickDeadlineUs = pWheel->TickAlarm.DeadlineUs;
+
+      (void)Timebase_AlarmStart(&pWheel->TickAlarm,
+                                pWheel->TickAlarm.Queue,
+                                TickDeadlineUs + (uint64)(Skip * TIMER_WHEEL_TICK_US),
+                                TIMER_WHEEL_TICK_US,
+                                &TimerWheel_TickCallback,
+                                (void*)pWheel);
+
+      pWheel->TickOverruns = 0UL;
+      pWheel->SkippedTicks = Skip;
+
+      TimerWheel_IdleStats[Core].Sleeps++;
+
+      CORE_ARCH_WAIT_FOR_INTERRUPT();
+
+      TimerWheel_IdleWake(pWheel, TickDeadlineUs, Skip);
+    }
+    else
+    {
+      /* the tick alarm stays on the next tick */
+      CORE_ARCH_WAIT_FOR_INTERRUPT();
+    }
+  }
+
+  /* the interrupt which woke up the core is served here */
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_ListInit function
+///
+/// \param  pHead : list head (circular list, empty when it points to itself)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_ListInit(timerWheelLink_t* pHead)
+{
+  pHead->pNext = pHead;
+  pHead->pPrev = pHead;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_ListAppend function
+///
+/// \param  pHead : list head
+///         pLink : node to link at the tail
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_ListAppend(timerWheelLink_t* pHead, timerWheelLink_t* pLink)
+{
+  pLink->pNext        = pHead;
+  pLink->pPrev        = pHead->pPrev;
+  pHead->pPrev->pNext = pLink;
+  pHead->pPrev        = pLink;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_ListUnlink function
+///
+/// \param  pLink : node to unlink (its list head is not needed)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_ListUnlink(timerWheelLink_t* pLink)
+{
+  pLink->pPrev->pNext = pLink->pNext;
+  pLink->pNext->pPrev = pLink->pPrev;
+  pLink->pNext        = pLink;
+  pLink->pPrev        = pLink;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_ListMove function
+///
+/// \descr  Move all the nodes of a list to an other (uninitialized) list head
+///
+/// \param  pFrom : source list head, empty on return
+///         pTo   : destination list head
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_ListMove(timerWheelLink_t* pFrom, timerWheelLink_t* pTo)
+{
+  if(pFrom->pNext == pFrom)
+  {
+    TimerWheel_ListInit(pTo);
+  }
+  else
+  {
+    pTo->pNext        = pFrom->pNext;
+    pTo->pPrev        = pFrom->pPrev;
+    pTo->pNext->pPrev = pTo;
+    pTo->pPrev->pNext = pTo;
+
+    TimerWheel_ListInit(pFrom);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Add function
+///
+/// \descr  Link a timer in the slot of the lowest level covering its expiry, an expiry
+///         already passed goes to the next processed slot (interrupts disabled).
+///
+/// \param  pWheel : wheel
+///         pTimer : timer with its expiry set
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_Add(timerWheel_t* pWheel, timerWheelTimer_t* pTimer)
+{
+  const uint32 Delta      = pTimer->Expiry - pWheel->Now;
+  timerWheelLink_t* pSlot = &pWheel->Slot[0][pWheel->Now & TIMER_WHEEL_SLOT_MASK];
+
+  if((sint32)Delta >= 0)
+  {
+    uint32 Level = 0UL;
+
+    while((Level < (TIMER_WHEEL_LEVELS - 1UL)) && (Delta >= (1UL << (TIMER_WHEEL_SLOT_BITS * (Level + 1UL)))))
+    {
+      Level++;
+    }
+
+    pSlot = &pWheel->Slot[Level][(pTimer->Expiry >> (TIMER_WHEEL_SLOT_BITS * Level)) & TIMER_WHEEL_SLOT_MASK];
+  }
+
+  TimerWheel_ListAppend(pSlot, &pTimer->Link);
+
+  pTimer->State = TIMER_WHEEL_STATE_PENDING;
+  pWheel->Active++;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Detach function
+///
+/// \descr  Unlink a timer from its slot or from the deferred list (interrupts disabled)
+///
+/// \param  pWheel : wheel of the timer
+///         pTimer : timer
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_Detach(timerWheel_t* pWheel, timerWheelTimer_t* pTimer)
+{
+  if(pTimer->State == TIMER_WHEEL_STATE_PENDING)
+  {
+    pWheel->Active--;
+  }
+
+  if(pTimer->State != TIMER_WHEEL_STATE_IDLE)
+  {
+    TimerWheel_ListUnlink(&pTimer->Link);
+  }
+
+  pTimer->State = TIMER_WHEEL_STATE_IDLE;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Cascade function
+///
+/// \descr  Redistribute the timers of an upper level slot to the lower levels
+///
+/// \param  pWheel : wheel
+///         Level  : 1..TIMER_WHEEL_LEVELS-1
+///         Index  : slot
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_Cascade(timerWheel_t* pWheel, uint32 Level, uint32 Index)
+{
+  timerWheelLink_t List;
+
+  TimerWheel_ListMove(&pWheel->Slot[Level][Index], &List);
+
+  while(List.pNext != &List)
+  {
+    timerWheelTimer_t* pTimer = (timerWheelTimer_t*)List.pNext;
+
+    TimerWheel_ListUnlink(&pTimer->Link);
+    pWheel->Active--;
+
+    TimerWheel_Add(pWheel, pTimer);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_Advance function
+///
+/// \descr  Process one tick: cascade the upper levels when the lower one wraps, then
+///         expire the timers of the current slot. The ISR context callbacks are
+///         called with the interrupt state of the caller restored.
+///
+/// \param  pWheel : wheel
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_Advance(timerWheel_t* pWheel)
+{
+  timerWheelLink_t Expired;
+
+  uint32 IrqState    = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+  const uint32 Index = pWheel->Now & TIMER_WHEEL_SLOT_MASK;
+
+  if(Index == 0UL)
+  {
+    for(uint32 Level = 1UL; Level < TIMER_WHEEL_LEVELS; Level++)
+    {
+      const uint32 LevelIndex = (pWheel->Now >> (TIMER_WHEEL_SLOT_BITS * Level)) & TIMER_WHEEL_SLOT_MASK;
+
+      TimerWheel_Cascade(pWheel, Level, LevelIndex);
+
+      if(LevelIndex != 0UL)
+      {
+        break;
+      }
+    }
+  }
+
+  TimerWheel_ListMove(&pWheel->Slot[0][Index], &Expired);
+
+  pWheel->Now++;
+
+  /* the callbacks may stop or restart any timer, the expired ones included */
+  while(Expired.pNext != &Expired)
+  {
+    timerWheelTimer_t* pTimer = (timerWheelTimer_t*)Expired.pNext;
+
+    TimerWheel_ListUnlink(&pTimer->Link);
+    pWheel->Active--;
+
+    if(pTimer->Context == TIMER_WHEEL_CONTEXT_DEFERRED)
+    {
+      TimerWheel_ListAppend(&pWheel->Deferred, &pTimer->Link);
+      pTimer->State = TIMER_WHEEL_STATE_EXPIRED;
+    }
+    else
+    {
+      pTimer->State = TIMER_WHEEL_STATE_IDLE;
+
+      if(pTimer->Period != 0UL)
+      {
+        pTimer->Expiry += pTimer->Period;
+        TimerWheel_Add(pWheel, pTimer);
+      }
+
+      CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+
+      pTimer->Callback(pTimer);
+
+      IrqState = CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS();
+    }
+  }
+
+  CORE_ARCH_RESTORE_INTERRUPTS(IrqState);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_TickCallback function
+///
+/// \descr  Tick alarm callback: the ticks skipped by a late interrupt are caught up
+///
+/// \param  pArg : wheel of the core
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_TickCallback(void* pArg)
+{
+  timerWheel_t* pWheel  = (timerWheel_t*)pArg;
+  const uint32 Overruns = pWheel->TickAlarm.Overruns;
+  const uint32 Ticks    = 1UL + (Overruns - pWheel->TickOverruns);
+
+  pWheel->TickOverruns = Overruns;
+
+  /* the ticks skipped by the tickless idle are empty: no processing needed */
+  pWheel->Now         += pWheel->SkippedTicks;
+  pWheel->SkippedTicks = 0UL;
+
+  for(uint32 Tick = 0UL; Tick < Ticks; Tick++)
+  {
+    TimerWheel_Advance(pWheel);
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_FreeTicks function
+///
+/// \descr  Count the ticks from Now without expiry nor cascade of a non-empty slot.
+///         A level 0 slot holds the expiries of the next 64 ticks, an upper level slot
+///         is cascaded when the ticks below it wrap (at most 4 x 64 slots are checked).
+///
+/// \param  pWheel : wheel (interrupts disabled)
+///
+/// \return the number of ticks which can be skipped, TIMER_WHEEL_MAX_TICKS if none is armed
+//-----------------------------------------------------------------------------------------
+static uint32 TimerWheel_FreeTicks(const timerWheel_t* pWheel)
+{
+  const uint32 Now = pWheel->Now;
+  uint32 Free      = TIMER_WHEEL_MAX_TICKS;
+
+  if(pWheel->Active != 0UL)
+  {
+    for(uint32 Level = 0UL; Level < TIMER_WHEEL_LEVELS; Level++)
+    {
+      const uint32 Shift   = TIMER_WHEEL_SLOT_BITS * Level;
+      const uint32 Current = (Now >> Shift) & TIMER_WHEEL_SLOT_MASK;
+
+      /* the current slot of an upper level is cascaded by the tick Now if it is aligned, */
+      /* else only at the next wrap of the level: it is then the farthest one            */
+      const boolean Aligned = ((Now & ((1UL << Shift) - 1UL)) == 0UL) ? TRUE : FALSE;
+      const uint32 First    = (TRUE == Aligned) ? 0UL : 1UL;
+      const uint32 Last     = (TRUE == Aligned) ? (TIMER_WHEEL_SLOTS - 1UL) : TIMER_WHEEL_SLOTS;
+
+      for(uint32 Distance = First; Distance <= Last; Distance++)
+      {
+        const timerWheelLink_t* pSlot = &pWheel->Slot[Level][(Current + Distance) & TIMER_WHEEL_SLOT_MASK];
+
+        if(pSlot->pNext != pSlot)
+        {
+          const uint32 Next = ((Now >> Shift) + Distance) << Shift;
+
+          Free = ((Next - Now) < Free) ? (Next - Now) : Free;
+
+          break;
+        }
+      }
+    }
+  }
+
+  return(Free);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  TimerWheel_IdleWake function
+///
+/// \descr  Compensate the wheel after a tickless sleep (interrupts disabled). Woken up
+///         by the wheel deadline, the tick callback jumps over the skipped ticks. Woken
+///         up earlier, the elapsed ticks are skipped here and the tick is re-armed in
+///         its original phase.
+///
+/// \param  pWheel         : wheel of the calling core
+///         TickDeadlineUs : deadline of the first skipped tick
+///         Skip           : ticks skipped
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void TimerWheel_IdleWake(timerWheel_t* pWheel, uint64 TickDeadlineUs, uint32 Skip)
+{
+  volatile timerWheelIdleStats_t* pStats = &TimerWheel_IdleStats[TIMER_WHEEL_CORE_ID()];
+  const uint64 NowUs                     = Timebase_GetUs();
+  const uint64 WakeDeadlineUs            = pWheel->TickAlarm.DeadlineUs;
+
+  if(NowUs >= WakeDeadlineUs)
+  {
+    const uint32 LatencyUs = (uint32)(NowUs - WakeDeadlineUs);
+
+    pStats->WakeLatencyMinUs  = ((pStats->TickWakes == 0UL) || (LatencyUs < pStats->WakeLatencyMinUs)) ? LatencyUs : pStats->WakeLatencyMinUs;
+    pStats->WakeLatencyMaxUs  = (LatencyUs > pStats->WakeLatencyMaxUs) ? LatencyUs : pStats->WakeLatencyMaxUs;
+    pStats->WakeLatencySumUs += LatencyUs;
+    pStats->TickWakes++;
+    pStats->SkippedTicks     += Skip;
+  }
+  else
+  {
+    /* the ticks whose deadline passed are empty (fewer than Skip) */
+    const uint32 Passed = (NowUs < TickDeadlineUs) ? 0UL : (((uint32)(NowUs - TickDeadlineUs) / TIMER_WHEEL_TICK_US) + 1UL);
+
+    pWheel->Now          += Passed;
+    pWheel->SkippedTicks  = 0UL;
+    pWheel->TickOverruns  = 0UL;
+
+    (void)Timebase_AlarmStart(&pWheel->TickAlarm,
+                              pWheel->TickAlarm.Queue,
+                              TickDeadlineUs + (uint64)(Passed * TIMER_WHEEL_TICK_US),
+                              TIMER_WHEEL_TICK_US,
+                              &TimerWheel_TickCallback,
+                              (void*)pWheel);
+
+    pStats->EarlyWakes++;
+    pStats->SkippedTicks += Passed;
+  }
+}
@@ -0,0 +1,105 @@
+/******************************************************************************************
+  Filename    : TimerWheel.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+  
+  Author      : Chalandi Amine
+  
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Hierarchical timing wheel header file
+  
+******************************************************************************************/
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+//=============================================================================
+// Includes
+//=============================================================================
+#include "Platform_Types.h"
+
+//=============================================================================
+// Defines
+//=============================================================================
+/* wheel tick period */
+#ifndef TIMER_WHEEL_TICK_US
+  #define TIMER_WHEEL_TICK_US     1000UL
+#endif
+
+/* 4 levels of 64 slots: timeouts up to 2^24 ticks (4.6 hours with the 1 ms tick) */
+#define TIMER_WHEEL_LEVELS        4UL
+#define TIMER_WHEEL_SLOT_BITS     6UL
+#define TIMER_WHEEL_SLOTS         (1UL << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_MAX_TICKS     ((1UL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1UL)
+
+#define TIMER_WHEEL_CORES         2UL
+
+/* TimerWheel_Init: wheel advanced by the application (TimerWheel_Process), no tick alarm */
+#define TIMER_WHEEL_NO_TICK       0xFFUL
+
+/* longest tickless sleep (the skipped time must fit 31 bits of us) */
+#define TIMER_WHEEL_IDLE_MAX_TICKS    (0x7FFFFFFFUL / TIMER_WHEEL_TICK_US)
+
+/* context of the expiry callback */
+#define TIMER_WHEEL_CONTEXT_ISR       0U   /* from the tick interrupt */
+#define TIMER_WHEEL_CONTEXT_DEFERRED  1U   /* from TimerWheel_RunDeferred */
+
+//=============================================================================
+// Types definition
+//=============================================================================
+typedef struct timerWheelLink
+{
+  struct timerWheelLink* pNext;
+  struct timerWheelLink* pPrev;
+}timerWheelLink_t;
+
+struct timerWheelTimer;
+
+/* the timer is passed back: embed it in the object that owns the timeout */
+typedef void (*timerWheelCallback_t)(struct timerWheelTimer* pTimer);
+
+typedef struct timerWheelTimer
+{
+  timerWheelLink_t      Link;      /* slot or deferred list node, must stay the first member */
+  uint32                Expiry;    /* absolute wheel tick */
+  uint32                Period;    /* ticks, 0: one-shot */
+  timerWheelCallback_t  Callback;
+  uint8                 Core;      /* wheel owning the timer */
+  uint8                 Context;   /* TIMER_WHEEL_CONTEXT_xxx */
+  uint8                 State;     /* owned by the wheel */
+}timerWheelTimer_t;
+
+typedef struct
+{
+  uint32  Sleeps;             /* tickless sleeps */
+  uint32  TickWakes;          /* woken up by the wheel deadline */
+  uint32  EarlyWakes;         /* woken up earlier by an other interrupt */
+  uint32  SkippedTicks;       /* ticks not interrupted */
+  uint32  WakeLatencyMinUs;   /* deadline to the first instruction after the sleep */
+  uint32  WakeLatencyMaxUs;
+  uint32  WakeLatencySumUs;   /* average: WakeLatencySumUs / TickWakes */
+}timerWheelIdleStats_t;
+
+//=============================================================================
+// Globals
+//=============================================================================
+extern volatile timerWheelIdleStats_t TimerWheel_IdleStats[TIMER_WHEEL_CORES];
+
+//=============================================================================
+// Functions prototype
+//=============================================================================
+void    TimerWheel_Init(uint32 Queue);
+boolean TimerWheel_Start(timerWheelTimer_t* pTimer, uint32 Ticks, uint32 PeriodTicks, timerWheelCallback_t Callback, uint32 Context);
+void    TimerWheel_Stop(timerWheelTimer_t* pTimer);
+boolean TimerWheel_IsActive(const timerWheelTimer_t* pTimer);
+uint32  TimerWheel_GetTicks(void);
+void    TimerWheel_Process(uint32 Ticks);
+uint32  TimerWheel_RunDeferred(void);
+uint32  TimerWheel_IdleTicks(void);
+void    TimerWheel_Idle(void);
+
+#endif /*__TIMER_WHEEL_H__*/
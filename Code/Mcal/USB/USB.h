@@ -20,8 +20,9 @@
 
 #include "Platform_Types.h"
 #include "usb_types.h"
+#include "Compiler.h"
 
-void USBCTRL_IRQ(void);
+void USBCTRL_IRQ(void) __time_critical;
 void UsbInit(void);
 void UsbDriver_SendSerialMsg(uint8* msg);
 boolean UsbDriver_IsDeviceConnected(void);
@@ -0,0 +1,81 @@
+// ***************************************************************************************
+// Filename    : BootTrace.c
+//
+// Author      : Chalandi Amine
+//
+// Owner       : Chalandi Amine
+//
+// Date        : 04.09.2024
+//
+// Description : Boot-stage timestamp recorder
+//
+//               The timestamps are taken from the TIMER0 raw counter which does not
+//               depend on the PLL. Its tick is derived from clk_ref (TICKS block):
+//               until the clock bring-up switches clk_ref to the XOSC,
+//               clk_ref runs from the ROSC and the first stage duration is only
+//               an approximation.
+//
+//               The record lives in .noinit, dump the RAM and decode it with:
+//               Tools/scripts/BootTraceDecoder.py
+//
+// ***************************************************************************************
+
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "BootTrace.h"
+#include "Compiler.h"
+#include "Clock.h"
+#include "RP2350.h"
+
+//=========================================================================================
+// globals
+//=========================================================================================
+/* Boot trace record (not initialized by the startup code, valid once Magic is set) */
+volatile bootTraceRecord_t BootTrace_Record __noinit;
+
+//-----------------------------------------------------------------------------------------
+/// \brief  BootTrace_Init function
+///
+/// \descr  Start the TIMER0 tick and the record, must be called first in Startup_Init.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void BootTrace_Init(void)
+{
+  /* Release the reset of TIMER0 and start its 1 us tick, same setup as the clock driver
+     (the counter keeps running if it is already out of reset) */
+  RP2350_ClockTickStart();
+
+  BootTrace_Record.Magic     = 0UL;
+  BootTrace_Record.Version   = BOOT_TRACE_VERSION;
+  BootTrace_Record.MarkCount = (uint32)BOOT_TRACE_MARK_NUMBER;
+
+  for(uint32 idx = 0; idx < (uint32)BOOT_TRACE_MARK_NUMBER; idx++)
+  {
+    BootTrace_Record.TimeStamp[idx] = BOOT_TRACE_NOT_RECORDED;
+  }
+
+  BootTrace_Record.TimeStamp[BOOT_TRACE_STARTUP_ENTRY] = HW_PER_TIMER0->TIMERAWL.reg;
+
+  BootTrace_Record.Magic = BOOT_TRACE_MAGIC;
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  BootTrace_Mark function
+///
+/// \descr  Record the current TIMER0 time for the given mark (callable from both cores).
+///
+/// \param  Mark : the boot trace mark
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void BootTrace_Mark(bootTraceMark_t Mark)
+{
+  if((BootTrace_Record.Magic == BOOT_TRACE_MAGIC) && (Mark < BOOT_TRACE_MARK_NUMBER))
+  {
+    BootTrace_Record.TimeStamp[Mark] = HW_PER_TIMER0->TIMERAWL.reg;
+  }
+}
@@ -0,0 +1,80 @@
+// ***************************************************************************************
+// Filename    : BootTrace.h
+//
+// Author      : Chalandi Amine
+//
+// Owner       : Chalandi Amine
+//
+// Date        : 04.09.2024
+//
+// Description : Boot-stage timestamp recorder header file
+//
+// ***************************************************************************************
+
+#ifndef __BOOT_TRACE_H__
+#define __BOOT_TRACE_H__
+
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "Platform_Types.h"
+#include "Compiler.h"
+
+//=========================================================================================
+// configuration
+//=========================================================================================
+/* Set to 0 to remove the boot trace marks from the build */
+#ifndef BOOT_TRACE_ENABLE
+  #define BOOT_TRACE_ENABLE   1
+#endif
+
+//=========================================================================================
+// defines
+//=========================================================================================
+#define BOOT_TRACE_MAGIC          0x54425442UL /* 'BTBT' */
+#define BOOT_TRACE_VERSION        3UL
+#define BOOT_TRACE_NOT_RECORDED   0xFFFFFFFFUL
+
+/* Boot trace marks (the record layout is decoded by Tools/scripts/BootTraceDecoder.py) */
+typedef enum
+{
+  BOOT_TRACE_STARTUP_ENTRY = 0,
+  BOOT_TRACE_INIT_CORE_DONE,
+  BOOT_TRACE_INIT_CLOCK_DONE,
+  BOOT_TRACE_INIT_RAM_DONE,
+  BOOT_TRACE_INIT_CTORS_DONE,
+  BOOT_TRACE_START_CORE1_ENTRY,
+  BOOT_TRACE_START_CORE1_DONE,
+  BOOT_TRACE_CORE1_ENTRY,
+  BOOT_TRACE_SYNC_CORE0_ENTRY,
+  BOOT_TRACE_SYNC_CORE0_DONE,
+  BOOT_TRACE_SYNC_CORE1_ENTRY,
+  BOOT_TRACE_SYNC_CORE1_DONE,
+  BOOT_TRACE_INIT_IMAGE_DONE,
+  BOOT_TRACE_INIT_CLOCK_START,
+  BOOT_TRACE_MARK_NUMBER
+}bootTraceMark_t;
+
+typedef struct
+{
+  uint32  Magic;                              /* BOOT_TRACE_MAGIC once the record is valid */
+  uint32  Version;                            /* BOOT_TRACE_VERSION */
+  uint32  MarkCount;                          /* BOOT_TRACE_MARK_NUMBER */
+  uint32  TimeStamp[BOOT_TRACE_MARK_NUMBER];  /* TIMER0 raw counter (us), BOOT_TRACE_NOT_RECORDED if not reached */
+}bootTraceRecord_t;
+
+#if BOOT_TRACE_ENABLE
+  #define BOOT_TRACE_INIT()        BootTrace_Init()
+  #define BOOT_TRACE_MARK(mark)    BootTrace_Mark(mark)
+#else
+  #define BOOT_TRACE_INIT()
+  #define BOOT_TRACE_MARK(mark)
+#endif
+
+//=========================================================================================
+// function prototype
+//=========================================================================================
+void BootTrace_Init(void) __boot_text;
+void BootTrace_Mark(bootTraceMark_t Mark);
+
+#endif /*__BOOT_TRACE_H__*/
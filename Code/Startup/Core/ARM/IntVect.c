@@ -15,12 +15,14 @@
   
 ******************************************************************************************/
 
+#include "Compiler.h"
+
 //=============================================================================
 // Types definition
 //=============================================================================
 typedef void (*InterruptHandler)(void);
 
-void UndefinedHandler(void);
+void UndefinedHandler(void) __boot_text;
 void UndefinedHandler(void) { for(;;); }
 
 //=============================================================================
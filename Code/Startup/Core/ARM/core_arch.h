@@ -24,8 +24,50 @@
 #define CORE_ARCH_DISABLE_INTERRUPTS() __asm("CPSID i")
 #define CORE_ARCH_ENABLE_INTERRUPTS()  __asm("CPSIE i")
 
+/* nestable critical section: returns the previous PRIMASK, restore it with CORE_ARCH_RESTORE_INTERRUPTS */
+#define CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS() ({ uint32 __primask; __asm volatile("MRS %0, PRIMASK\n CPSID i" : "=r"(__primask) : : "memory"); __primask; })
+#define CORE_ARCH_RESTORE_INTERRUPTS(state)     __asm volatile("MSR PRIMASK, %0" : : "r"((uint32)(state)) : "memory")
+
+/* enable an external interrupt line in the NVIC of the calling core */
+#define CORE_ARCH_NVIC_ISER_REG(n)     (*(volatile uint32*)(0xE000E100UL + (4UL * ((uint32)(n) >> 5))))
+#define CORE_ARCH_ENABLE_IRQ(n)        do { CORE_ARCH_NVIC_ISER_REG(n) = 1UL << ((uint32)(n) & 31UL); } while(0)
+
+/* sleep until an interrupt is pending (wakes up even with the interrupts masked by PRIMASK) */
+#define CORE_ARCH_WAIT_FOR_INTERRUPT() __asm volatile("DSB\n WFI" : : : "memory")
+
+/* sleep until an event (SEV of the other core, interrupt), returns at once if an event is latched */
+#define CORE_ARCH_WAIT_FOR_EVENT()     __asm volatile("WFE" : : : "memory")
+
+/* wake up the other core from WFE: the DSB completes the stores of the released condition before the SEV */
+#define CORE_ARCH_SEND_EVENT()         __asm volatile("DSB\n SEV" : : : "memory")
+
+/* DWT cycle counter (CoreDebug DEMCR.TRCENA must be set to enable the DWT unit) */
+#define CORE_ARCH_DEMCR_REG            (*(volatile uint32*)0xE000EDFCUL)
+#define CORE_ARCH_DWT_CTRL_REG         (*(volatile uint32*)0xE0001000UL)
+#define CORE_ARCH_DWT_CYCCNT_REG       (*(volatile uint32*)0xE0001004UL)
+
+#define CORE_ARCH_CYCLE_COUNTER_INIT() do { CORE_ARCH_DEMCR_REG |= (1UL << 24); CORE_ARCH_DWT_CTRL_REG |= 1UL; } while(0)
+#define CORE_ARCH_CYCLE_COUNTER_READ() (CORE_ARCH_DWT_CYCCNT_REG)
+
+/* memory ordering between the cores: acquire after loading a flag, release before storing it */
+#define CORE_ARCH_ACQUIRE_BARRIER()    __asm volatile("DMB" : : : "memory")
+#define CORE_ARCH_RELEASE_BARRIER()    __asm volatile("DMB" : : : "memory")
+#define CORE_ARCH_MEMORY_BARRIER()     __asm volatile("DMB" : : : "memory")
+
+/* make the code written to the memory visible to the instruction fetch */
+#define CORE_ARCH_INSTRUCTION_SYNC()   do { __asm volatile("DSB"); __asm volatile("ISB"); } while(0)
+
+/* the vector tables hold absolute addresses, SRAM handlers need no switch */
+#define CORE_ARCH_INIT_RAM_VECTORS()
+
 
 void arch_spin_lock(uint32* lock);
+uint32 arch_spin_trylock(uint32* lock);
 void arch_spin_unlock(uint32* lock);
+uint32 arch_atomic_fetch_add(volatile uint32* word, uint32 value);
+uint32 arch_atomic_swap(volatile uint32* word, uint32 value);
+uint32 arch_atomic_cas(volatile uint32* word, uint32 expected, uint32 value);
+void arch_block_clear(uint32* dst, uint32 blocks);
+void arch_block_copy(uint32* dst, const uint32* src, uint32 blocks);
 
 #endif //__CORE_ARCH_H__
@@ -18,32 +18,11 @@
 .cpu cortex-m33
 
 /*******************************************************************************************
-  \brief  
-
-  \param  
-  
-  \return 
-********************************************************************************************/
-.thumb_func
-.section ".text", "ax"
-.align 8
-.globl BlockingDelay
-.type  BlockingDelay, % function
-
-
-BlockingDelay:
-                      subs r0, r0, #1
-                      bne BlockingDelay
-                      bx lr
-
-.size BlockingDelay, .-BlockingDelay
-
-/*******************************************************************************************
-  \brief  
+  \brief  Acquire an exclusive-access spinlock (0: free, 1: taken), sleeps in WFE while taken
   
-  \param  
+  \param  r0 : lock word address
   
-  \return 
+  \return void
 ********************************************************************************************/
 .thumb_func
 .section ".text", "ax"
@@ -57,22 +36,60 @@ arch_spin_lock:
 .L_loop:
     ldaex   r2, [r0]            // Load exclusive value
     cmp     r2, #0              // Check if lock is free
-    bne     .L_loop                // Retry if not free
+    bne     .L_wait             // Sleep if not free
     strex   r2, r1, [r0]        // Try to acquire the lock
     cmp     r2, #0              // Check if successful
     bne     .L_loop                // Retry if not
     dmb                         // Ensure memory ordering after acquiring the lock
     bx      lr                  // Return if successful
+.L_wait:
+    clrex                       // Drop the reservation
+    wfe                         // Sleep until the SEV of arch_spin_unlock
+    b       .L_loop
 
 
 .size arch_spin_lock, .-arch_spin_lock
 
 /*******************************************************************************************
-  \brief  
+  \brief  Try once to acquire an exclusive-access spinlock
   
-  \param  
+  \param  r0 : lock word address
   
-  \return 
+  \return r0 : 1 if the lock is acquired, 0 if it is taken
+********************************************************************************************/
+.thumb_func
+.section ".text", "ax"
+.align 2
+.globl arch_spin_trylock
+.type  arch_spin_trylock, % function
+
+
+arch_spin_trylock:
+    mov     r1, #1
+.L_trylock_retry:
+    ldaex   r2, [r0]            // Load exclusive value
+    cmp     r2, #0              // Check if lock is free
+    bne     .L_trylock_taken    // Give up if taken
+    strex   r2, r1, [r0]        // Try to acquire the lock
+    cmp     r2, #0              // Lost the reservation: retry
+    bne     .L_trylock_retry
+    dmb                         // Ensure memory ordering after acquiring the lock
+    mov     r0, #1
+    bx      lr
+.L_trylock_taken:
+    clrex                       // Drop the reservation
+    mov     r0, #0
+    bx      lr
+
+
+.size arch_spin_trylock, .-arch_spin_trylock
+
+/*******************************************************************************************
+  \brief  Release an exclusive-access spinlock and wake up the waiting core (SEV)
+  
+  \param  r0 : lock word address (lock held by the caller)
+  
+  \return void
 ********************************************************************************************/
 .thumb_func
 .section ".text", "ax"
@@ -85,8 +102,173 @@ arch_spin_unlock:
     dmb                         // Ensure memory operations before unlocking
     mov     r1, #0              // Clear the lock
     stl     r1, [r0]            // Store with release semantics
+    dsb                         // The store completes before the wake-up
+    sev                         // Wake up the waiting core
     bx      lr                  // Return
 
 
 .size arch_spin_unlock, .-arch_spin_unlock
 
+/*******************************************************************************************
+  \brief  Atomic fetch-and-add (full barrier before and after)
+  
+  \param  r0 : word address
+          r1 : value to add
+  
+  \return r0 : previous value
+********************************************************************************************/
+.thumb_func
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_fetch_add
+.type  arch_atomic_fetch_add, % function
+
+
+arch_atomic_fetch_add:
+    dmb
+.L_fetch_add_retry:
+    ldaex   r2, [r0]            // Load exclusive value
+    add     r3, r2, r1
+    stlex   ip, r3, [r0]        // Try to store the sum
+    cmp     ip, #0
+    bne     .L_fetch_add_retry
+    dmb
+    mov     r0, r2
+    bx      lr
+
+
+.size arch_atomic_fetch_add, .-arch_atomic_fetch_add
+
+/*******************************************************************************************
+  \brief  Atomic swap (full barrier before and after)
+  
+  \param  r0 : word address
+          r1 : new value
+  
+  \return r0 : previous value
+********************************************************************************************/
+.thumb_func
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_swap
+.type  arch_atomic_swap, % function
+
+
+arch_atomic_swap:
+    dmb
+.L_swap_retry:
+    ldaex   r2, [r0]            // Load exclusive value
+    stlex   r3, r1, [r0]        // Try to store the new value
+    cmp     r3, #0
+    bne     .L_swap_retry
+    dmb
+    mov     r0, r2
+    bx      lr
+
+
+.size arch_atomic_swap, .-arch_atomic_swap
+
+/*******************************************************************************************
+  \brief  Atomic compare-and-swap (full barrier before and after a successful swap)
+  
+  \param  r0 : word address
+          r1 : expected value
+          r2 : new value (stored if the word holds the expected value)
+  
+  \return r0 : previous value (equal to the expected value on success)
+********************************************************************************************/
+.thumb_func
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_cas
+.type  arch_atomic_cas, % function
+
+
+arch_atomic_cas:
+    dmb
+.L_cas_retry:
+    ldaex   r3, [r0]            // Load exclusive value
+    cmp     r3, r1
+    bne     .L_cas_fail         // Not the expected value: give up
+    stlex   ip, r2, [r0]        // Try to store the new value
+    cmp     ip, #0
+    bne     .L_cas_retry
+    dmb
+    mov     r0, r3
+    bx      lr
+.L_cas_fail:
+    clrex                       // Drop the reservation
+    mov     r0, r3
+    bx      lr
+
+
+.size arch_atomic_cas, .-arch_atomic_cas
+
+/*******************************************************************************************
+  \brief  Clear a word-aligned memory area in blocks of 32 bytes (8 words per STM)
+  
+  \param  r0 : destination address (word aligned)
+          r1 : number of 32-byte blocks
+  
+  \return void
+********************************************************************************************/
+.thumb_func
+.section ".text", "ax"
+.align 2
+.globl arch_block_clear
+.type  arch_block_clear, % function
+
+
+arch_block_clear:
+    cbz     r1, .L_block_clear_end   // Nothing to do
+    push    {r4-r9}
+    movs    r2, #0
+    movs    r3, #0
+    movs    r4, #0
+    movs    r5, #0
+    movs    r6, #0
+    movs    r7, #0
+    mov     r8, #0
+    mov     r9, #0
+.L_block_clear_loop:
+    stmia   r0!, {r2-r9}             // Store 8 words and post-increment the destination
+    subs    r1, r1, #1
+    bne     .L_block_clear_loop
+    pop     {r4-r9}
+.L_block_clear_end:
+    bx      lr
+
+
+.size arch_block_clear, .-arch_block_clear
+
+/*******************************************************************************************
+  \brief  Copy a word-aligned memory area in blocks of 32 bytes (8 words per LDM/STM)
+  
+  \param  r0 : destination address (word aligned)
+          r1 : source address (word aligned)
+          r2 : number of 32-byte blocks
+  
+  \return void
+********************************************************************************************/
+.thumb_func
+.section ".boot_text", "ax"
+.align 2
+.globl arch_block_copy
+.type  arch_block_copy, % function
+
+
+arch_block_copy:
+    cbz     r2, .L_block_copy_end    // Nothing to do
+    push    {r4-r10}
+.L_block_copy_loop:
+    ldmia   r1!, {r3-r10}            // Load 8 words and post-increment the source
+    stmia   r0!, {r3-r10}            // Store 8 words and post-increment the destination
+    subs    r2, r2, #1
+    bne     .L_block_copy_loop
+    pop     {r4-r10}
+.L_block_copy_end:
+    bx      lr
+
+
+.size arch_block_copy, .-arch_block_copy
+
@@ -16,14 +16,15 @@
 ******************************************************************************************/
 
 #include "riscv.h"
+#include "Compiler.h"
 
 //=============================================================================
 // Types definition
 //=============================================================================
 typedef void (*InterruptHandler)(void);
 
-__attribute__((interrupt)) void Isr_MachineExternalInterrupt(void);
-void UndefinedHandler(void);
+__attribute__((interrupt)) void Isr_MachineExternalInterrupt(void) __time_critical;
+void UndefinedHandler(void) __time_critical;
 void UndefinedHandler(void) { for(;;); }
 
 //=============================================================================
@@ -7,7 +7,7 @@
   
   \return 
 ********************************************************************************************/
-.section .text
+.section .boot_text, "ax"
 .type _start_c0, @function
 .align 4
 .extern __CORE0_STACK_TOP
@@ -26,9 +26,9 @@ _start_c0:
         /* setup the stack pointer */
         la sp, __CORE0_STACK_TOP
        
-        /* setup the direct interrupt handler */
-        la t0, _VectoredInterruptVectorTable
-        addi t0, t0, 1
+        /* setup the early exception handler (direct mode), the vector table */
+        /* is in SRAM and is selected by Startup_Init after the RAM init    */
+        la t0, EarlyExceptionHandler
         csrw mtvec, t0
 
         /* setup C/C++ runtime environment */
@@ -80,7 +80,7 @@ _start_c1:
   
   \return 
 ********************************************************************************************/
-.section .riscv_intvect
+.section .riscv_intvect, "ax"
 .align 4
 .type _VectoredInterruptVectorTable, @function
 .globl Isr_MachineSoftwareInterrupt
@@ -107,7 +107,7 @@ _VectoredInterruptVectorTable:
 .size _VectoredInterruptVectorTable, .-_VectoredInterruptVectorTable
 
 
-.section .text
+.section .ramfunc, "ax"
 .type Isr_UndefinedHandler, @function
 .align 4
 Isr_UndefinedHandler: j Isr_UndefinedHandler
@@ -115,9 +115,17 @@ Isr_UndefinedHandler: j Isr_UndefinedHandler
 
 
 
-.section .text
+.section .ramfunc, "ax"
 .type AllExceptionsHandler, @function
 .align 4
 AllExceptionsHandler: j AllExceptionsHandler
 .size AllExceptionsHandler, .-AllExceptionsHandler
 
+
+
+.section .boot_text, "ax"
+.type EarlyExceptionHandler, @function
+.align 4
+EarlyExceptionHandler: j EarlyExceptionHandler
+.size EarlyExceptionHandler, .-EarlyExceptionHandler
+
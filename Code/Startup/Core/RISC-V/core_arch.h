@@ -24,8 +24,48 @@
 #define CORE_ARCH_DISABLE_INTERRUPTS() riscv_clear_csr(RVCSR_MSTATUS_OFFSET, 0x08ul)
 #define CORE_ARCH_ENABLE_INTERRUPTS()  riscv_set_csr(RVCSR_MSTATUS_OFFSET, 0x08ul)
 
+/* nestable critical section: returns the previous mstatus.MIE, restore it with CORE_ARCH_RESTORE_INTERRUPTS */
+#define CORE_ARCH_SAVE_AND_DISABLE_INTERRUPTS() ((uint32)riscv_read_clear_csr(RVCSR_MSTATUS_OFFSET, 0x08ul))
+#define CORE_ARCH_RESTORE_INTERRUPTS(state)     riscv_set_csr(RVCSR_MSTATUS_OFFSET, ((uint32)(state)) & 0x08ul)
+
+/* enable an external interrupt line in the Xh3irq controller of the calling core (meiea window n/16) */
+#define CORE_ARCH_ENABLE_IRQ(n)        do { riscv_set_csr(RVCSR_MEIEA_OFFSET, ((uint32)(n) >> 4) | (1UL << (16UL + ((uint32)(n) & 15UL)))); \
+                                            riscv_set_csr(RVCSR_MIE_OFFSET, RVCSR_MIE_MEIE_BITS); } while(0)
+
+/* sleep until an interrupt enabled in mie is pending (mstatus.MIE does not matter) */
+#define CORE_ARCH_WAIT_FOR_INTERRUPT() __asm volatile("wfi" : : : "memory")
+
+/* h3.block: sleep until h3.unblock of the other core (or an interrupt), returns at once if an unblock is latched */
+#define CORE_ARCH_WAIT_FOR_EVENT()     __asm volatile("slt x0, x0, x0" : : : "memory")
+
+/* h3.unblock: wake up the other core from h3.block after the stores of the released condition */
+#define CORE_ARCH_SEND_EVENT()         __asm volatile("slt x0, x0, x1" : : : "memory")
+
+/* mcycle counter (inhibited out of reset on Hazard3) */
+#define CORE_ARCH_CYCLE_COUNTER_INIT() riscv_clear_csr(RVCSR_MCOUNTINHIBIT_OFFSET, RVCSR_MCOUNTINHIBIT_CY_BITS)
+#define CORE_ARCH_CYCLE_COUNTER_READ() ((uint32)riscv_read_csr(RVCSR_MCYCLE_OFFSET))
+
+/* memory ordering between the cores: acquire after loading a flag, release before storing it */
+#define CORE_ARCH_ACQUIRE_BARRIER()    __asm volatile("fence r, rw" : : : "memory")
+#define CORE_ARCH_RELEASE_BARRIER()    __asm volatile("fence rw, w" : : : "memory")
+#define CORE_ARCH_MEMORY_BARRIER()     __asm volatile("fence rw, rw" : : : "memory")
+
+/* make the code written to the memory visible to the instruction fetch */
+#define CORE_ARCH_INSTRUCTION_SYNC()   __asm volatile("fence.i")
+
+/* switch mtvec to the SRAM vector table (valid once the copy table is processed) */
+#define CORE_ARCH_INIT_RAM_VECTORS()   riscv_write_csr(RVCSR_MTVEC_OFFSET, ((uint32)&_VectoredInterruptVectorTable) | 1UL)
+
+extern uint32 _VectoredInterruptVectorTable;
+
 
 void arch_spin_lock(uint32* lock);
+uint32 arch_spin_trylock(uint32* lock);
 void arch_spin_unlock(uint32* lock);
+uint32 arch_atomic_fetch_add(volatile uint32* word, uint32 value);
+uint32 arch_atomic_swap(volatile uint32* word, uint32 value);
+uint32 arch_atomic_cas(volatile uint32* word, uint32 expected, uint32 value);
+void arch_block_clear(uint32* dst, uint32 blocks);
+void arch_block_copy(uint32* dst, const uint32* src, uint32 blocks);
 
 #endif //__CORE_ARCH_H__
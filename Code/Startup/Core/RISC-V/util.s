@@ -14,54 +14,64 @@
 .file "util.s"
 
 /*******************************************************************************************
-  \brief  
+  \brief  Acquire an exclusive-access spinlock (0: free, 1: taken), sleeps in h3.block while taken
   
-  \param  
+  \param  a0 : lock word address
   
-  \return 
+  \return void
 ********************************************************************************************/
 .section ".text", "ax"
 .align 2
-.globl BlockingDelay
-.type  BlockingDelay, @function
-
+.globl arch_spin_lock
+.type  arch_spin_lock, @function
 
-BlockingDelay:
-               addi a0, a0, -1 
-               bnez a0, BlockingDelay
-               ret
 
+arch_spin_lock:  lr.w.aq a1, (a0)
+                 bne zero, a1, .L_lock_wait
+                 add a1, zero, 1
+                 sc.w t0, a1, (a0)
+                 bnez t0, arch_spin_lock
+                 ret
+/* h3.block: sleep until the h3.unblock of arch_spin_unlock */
+.L_lock_wait:    slt x0, x0, x0
+                 j arch_spin_lock
 
-.size BlockingDelay, .-BlockingDelay
+.size arch_spin_lock, .-arch_spin_lock
 
 /*******************************************************************************************
-  \brief  
+  \brief  Try once to acquire an exclusive-access spinlock
   
-  \param  
+  \param  a0 : lock word address
   
-  \return 
+  \return a0 : 1 if the lock is acquired, 0 if it is taken
 ********************************************************************************************/
 .section ".text", "ax"
 .align 2
-.globl arch_spin_lock
-.type  arch_spin_lock, @function
+.globl arch_spin_trylock
+.type  arch_spin_trylock, @function
 
 
-arch_spin_lock:  lr.w a1, (a0)
-                 bne zero, a1, arch_spin_lock
-                 add a1, zero, 1
-                 sc.w t0, a1, (a0)
-                 bnez t0, arch_spin_lock
-                 ret
+arch_spin_trylock:     lr.w.aq a1, (a0)
+                       bnez a1, .L_trylock_taken
+                       add a1, zero, 1
+                       sc.w t0, a1, (a0)
+                       bnez t0, arch_spin_trylock
+                       add a0, zero, 1
+                       ret
+.L_trylock_taken:      add a0, zero, 0
+                       ret
 
-.size arch_spin_lock, .-arch_spin_lock
+.size arch_spin_trylock, .-arch_spin_trylock
 
 /*******************************************************************************************
-  \brief  
+  \brief  Release an exclusive-access spinlock and wake up the waiting core (h3.unblock)
   
-  \param  
+  \param  a0 : lock word address (lock held by the caller)
   
-  \return 
+  \return void
+  
+  \note   Only the owner writes the taken lock: a release fence and a plain store are
+          enough (no LR/SC retry loop).
 ********************************************************************************************/
 .section ".text", "ax"
 .align 2
@@ -69,12 +79,143 @@ arch_spin_lock:  lr.w a1, (a0)
 .type  arch_spin_unlock, @function
 
 
-arch_spin_unlock: lr.w a1, (a0)
-                  add a2, zero, 1
-                  bne a2, a1, arch_spin_unlock
-                  sc.w t0, zero, (a0)
-                  bnez t0, arch_spin_unlock
+arch_spin_unlock: fence rw, w
+                  sw zero, 0(a0)
+/* h3.unblock: wake up the waiting core */
+                  slt x0, x0, x1
                   ret
 
 .size arch_spin_unlock, .-arch_spin_unlock
 
+/*******************************************************************************************
+  \brief  Atomic fetch-and-add (acquire and release ordering)
+  
+  \param  a0 : word address
+          a1 : value to add
+  
+  \return a0 : previous value
+********************************************************************************************/
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_fetch_add
+.type  arch_atomic_fetch_add, @function
+
+
+arch_atomic_fetch_add: amoadd.w.aqrl a0, a1, (a0)
+                       ret
+
+.size arch_atomic_fetch_add, .-arch_atomic_fetch_add
+
+/*******************************************************************************************
+  \brief  Atomic swap (acquire and release ordering)
+  
+  \param  a0 : word address
+          a1 : new value
+  
+  \return a0 : previous value
+********************************************************************************************/
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_swap
+.type  arch_atomic_swap, @function
+
+
+arch_atomic_swap:      amoswap.w.aqrl a0, a1, (a0)
+                       ret
+
+.size arch_atomic_swap, .-arch_atomic_swap
+
+/*******************************************************************************************
+  \brief  Atomic compare-and-swap (acquire and release ordering on success)
+  
+  \param  a0 : word address
+          a1 : expected value
+          a2 : new value (stored if the word holds the expected value)
+  
+  \return a0 : previous value (equal to the expected value on success)
+********************************************************************************************/
+.section ".text", "ax"
+.align 2
+.globl arch_atomic_cas
+.type  arch_atomic_cas, @function
+
+
+arch_atomic_cas:       lr.w.aqrl t0, (a0)
+                       bne t0, a1, .L_cas_end
+                       sc.w.rl t1, a2, (a0)
+                       bnez t1, arch_atomic_cas
+.L_cas_end:            mv a0, t0
+                       ret
+
+.size arch_atomic_cas, .-arch_atomic_cas
+
+/*******************************************************************************************
+  \brief  Clear a word-aligned memory area in blocks of 32 bytes (8 unrolled sw)
+  
+  \param  a0 : destination address (word aligned)
+          a1 : number of 32-byte blocks
+  
+  \return void
+********************************************************************************************/
+.section ".text", "ax"
+.align 2
+.globl arch_block_clear
+.type  arch_block_clear, @function
+
+
+arch_block_clear:      beqz a1, .L_block_clear_end
+.L_block_clear_loop:   sw zero,  0(a0)
+                       sw zero,  4(a0)
+                       sw zero,  8(a0)
+                       sw zero, 12(a0)
+                       sw zero, 16(a0)
+                       sw zero, 20(a0)
+                       sw zero, 24(a0)
+                       sw zero, 28(a0)
+                       addi a0, a0, 32
+                       addi a1, a1, -1
+                       bnez a1, .L_block_clear_loop
+.L_block_clear_end:    ret
+
+.size arch_block_clear, .-arch_block_clear
+
+/*******************************************************************************************
+  \brief  Copy a word-aligned memory area in blocks of 32 bytes (8 unrolled lw/sw)
+  
+  \param  a0 : destination address (word aligned)
+          a1 : source address (word aligned)
+          a2 : number of 32-byte blocks
+  
+  \return void
+********************************************************************************************/
+.section ".boot_text", "ax"
+.align 2
+.globl arch_block_copy
+.type  arch_block_copy, @function
+
+
+arch_block_copy:       beqz a2, .L_block_copy_end
+.L_block_copy_loop:    lw t0,  0(a1)
+                       lw t1,  4(a1)
+                       lw t2,  8(a1)
+                       lw t3, 12(a1)
+                       lw t4, 16(a1)
+                       lw t5, 20(a1)
+                       lw t6, 24(a1)
+                       lw a3, 28(a1)
+                       sw t0,  0(a0)
+                       sw t1,  4(a0)
+                       sw t2,  8(a0)
+                       sw t3, 12(a0)
+                       sw t4, 16(a0)
+                       sw t5, 20(a0)
+                       sw t6, 24(a0)
+                       sw a3, 28(a0)
+                       addi a0, a0, 32
+                       addi a1, a1, 32
+                       addi a2, a2, -1
+                       bnez a2, .L_block_copy_loop
+.L_block_copy_end:     ret
+
+.size arch_block_copy, .-arch_block_copy
+
@@ -0,0 +1,110 @@
+// ***************************************************************************************
+// Filename    : InitLevel.c
+//
+// Author      : Chalandi Amine
+//
+// Owner       : Chalandi Amine
+//
+// Date        : 04.09.2024
+//
+// Description : Prioritized initialization levels
+//
+//               The functions registered with INIT_LEVEL_REGISTER() are collected by
+//               the linker in the .init_levels section, one sorted block per level
+//               (see Memory_Map.ld), and are executed by InitLevel_Run().
+//
+// ***************************************************************************************
+
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "InitLevel.h"
+#include "Compiler.h"
+#include "RP2350.h"
+
+//=========================================================================================
+// linker variables
+//=========================================================================================
+extern const pFunc __INIT_LEVEL_0_START[];
+extern const pFunc __INIT_LEVEL_1_START[];
+extern const pFunc __INIT_LEVEL_2_START[];
+extern const pFunc __INIT_LEVEL_3_START[];
+extern const pFunc __INIT_LEVEL_4_START[];
+extern const pFunc __INIT_LEVEL_END[];
+
+//=========================================================================================
+// macros
+//=========================================================================================
+#define INIT_LEVEL_TIME()   ((uint32)HW_PER_TIMER0->TIMERAWL.reg)
+
+//=========================================================================================
+// globals
+//=========================================================================================
+/* not initialized by the startup code: the first levels run before the RAM init */
+volatile initLevelProfile_t InitLevel_Profile __noinit;
+
+static const pFunc* const InitLevel_Table[INIT_LEVEL_NUMBER + 1] =
+{
+  __INIT_LEVEL_0_START,
+  __INIT_LEVEL_1_START,
+  __INIT_LEVEL_2_START,
+  __INIT_LEVEL_3_START,
+  __INIT_LEVEL_4_START,
+  __INIT_LEVEL_END
+};
+
+//-----------------------------------------------------------------------------------------
+/// \brief  InitLevel_Run function
+///
+/// \descr  Execute the functions registered in the given level (lowest priority first)
+///         and record the level timing. Running INIT_LEVEL_EARLY resets the profile.
+///
+/// \param  Level : INIT_LEVEL_xxx
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void InitLevel_Run(uint32 Level)
+{
+  if(Level < (uint32)INIT_LEVEL_NUMBER)
+  {
+    if(Level == (uint32)INIT_LEVEL_EARLY)
+    {
+      for(uint32 idx = 0; idx < (uint32)INIT_LEVEL_NUMBER; idx++)
+      {
+        InitLevel_Profile.Level[idx].Done            = 0UL;
+        InitLevel_Profile.Level[idx].Count           = 0UL;
+        InitLevel_Profile.Level[idx].Duration        = 0UL;
+        InitLevel_Profile.Level[idx].SlowestEntry    = 0UL;
+        InitLevel_Profile.Level[idx].SlowestDuration = 0UL;
+      }
+    }
+
+    const uint32 LevelStart = INIT_LEVEL_TIME();
+    uint32 Count            = 0UL;
+    uint32 SlowestEntry     = 0UL;
+    uint32 SlowestDuration  = 0UL;
+
+    for(const pFunc* pEntry = InitLevel_Table[Level]; pEntry < InitLevel_Table[Level + 1UL]; pEntry++)
+    {
+      const uint32 EntryStart = INIT_LEVEL_TIME();
+
+      (*pEntry)();
+
+      const uint32 EntryDuration = INIT_LEVEL_TIME() - EntryStart;
+
+      if((Count == 0UL) || (EntryDuration > SlowestDuration))
+      {
+        SlowestEntry    = (uint32)(*pEntry);
+        SlowestDuration = EntryDuration;
+      }
+
+      Count++;
+    }
+
+    InitLevel_Profile.Level[Level].Duration        = INIT_LEVEL_TIME() - LevelStart;
+    InitLevel_Profile.Level[Level].Count           = Count;
+    InitLevel_Profile.Level[Level].SlowestEntry    = SlowestEntry;
+    InitLevel_Profile.Level[Level].SlowestDuration = SlowestDuration;
+    InitLevel_Profile.Level[Level].Done            = 1UL;
+  }
+}
@@ -0,0 +1,73 @@
+// ***************************************************************************************
+// Filename    : InitLevel.h
+//
+// Author      : Chalandi Amine
+//
+// Owner       : Chalandi Amine
+//
+// Date        : 04.09.2024
+//
+// Description : Prioritized initialization levels header file
+//
+// ***************************************************************************************
+
+#ifndef __INIT_LEVEL_H__
+#define __INIT_LEVEL_H__
+
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "Platform_Types.h"
+
+//=========================================================================================
+// defines
+//=========================================================================================
+/* Initialization levels, in execution order:                                            */
+/*   EARLY      : first code after the image copy (no clock setup, .data/.bss not valid)  */
+/*   PRE_CLOCK  : after the core init, before the system clock (.data/.bss not valid)     */
+/*   POST_CLOCK : system clock running and RAM initialized                                */
+/*   APP        : after the C++ constructors, right before main()                        */
+/*   DEFERRED   : off the boot critical path, run by core 1 after the multicore sync     */
+#define INIT_LEVEL_EARLY        0
+#define INIT_LEVEL_PRE_CLOCK    1
+#define INIT_LEVEL_POST_CLOCK   2
+#define INIT_LEVEL_APP          3
+#define INIT_LEVEL_DEFERRED     4
+#define INIT_LEVEL_NUMBER       5
+
+#define INIT_LEVEL_STRINGIFY(x)            #x
+#define INIT_LEVEL_SECTION(level, prio)    ".init_level." INIT_LEVEL_STRINGIFY(level) "." INIT_LEVEL_STRINGIFY(prio)
+
+/* Register an init function: void func(void), level: INIT_LEVEL_xxx, prio: 0..65535 (lowest first) */
+#define INIT_LEVEL_REGISTER(func, level, prio)                                                   \
+  static const pFunc InitLevel_Entry_##func __attribute__((used, section(INIT_LEVEL_SECTION(level, prio)))) = &func
+
+//=========================================================================================
+// types definitions
+//=========================================================================================
+typedef struct
+{
+  uint32  Done;             /* 1 once the level was executed */
+  uint32  Count;            /* number of registered functions */
+  uint32  Duration;         /* level execution time (us) */
+  uint32  SlowestEntry;     /* address of the slowest function of the level */
+  uint32  SlowestDuration;  /* its execution time (us) */
+}initLevelProfileEntry_t;
+
+typedef struct
+{
+  initLevelProfileEntry_t  Level[INIT_LEVEL_NUMBER];
+}initLevelProfile_t;
+
+//=========================================================================================
+// globals
+//=========================================================================================
+/* Per-level timing (TIMER0 raw counter started by BootTrace_Init), read it with the debugger */
+extern volatile initLevelProfile_t InitLevel_Profile;
+
+//=========================================================================================
+// function prototype
+//=========================================================================================
+void InitLevel_Run(uint32 Level);
+
+#endif /*__INIT_LEVEL_H__*/
@@ -11,6 +11,32 @@
 // 
 // ***************************************************************************************
 
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "Startup.h"
+#include "BootTrace.h"
+#include "InitLevel.h"
+#include "core_arch.h"
+
+//=========================================================================================
+// configuration
+//=========================================================================================
+/* Set to 1 to fall back to the byte-wise RAM initialization (profiling reference) */
+#ifndef STARTUP_RAM_INIT_BYTEWISE
+  #define STARTUP_RAM_INIT_BYTEWISE         0
+#endif
+
+/* Set to 1 to launch core 1 early and let it clear the upper half of each clear table region */
+#ifndef STARTUP_DUAL_CORE_RAM_INIT
+  #define STARTUP_DUAL_CORE_RAM_INIT        0
+#endif
+
+/* Number of clear/copy table entries recorded in Startup_RamInitProfile */
+#ifndef STARTUP_RAM_INIT_PROFILE_ENTRIES
+  #define STARTUP_RAM_INIT_PROFILE_ENTRIES  8UL
+#endif
+
 //=========================================================================================
 // types definitions
 //=========================================================================================
@@ -27,36 +53,88 @@ typedef struct
   unsigned long  size;  /* length of section (bytes) */
 } runtimeClearTable_t;
 
+typedef struct
+{
+  unsigned long  Addr;    /* target Address (section in RAM memory) */
+  unsigned long  size;    /* length of section (bytes) */
+  unsigned long  cycles;  /* cpu cycles spent to initialize the section */
+} runtimeInitProfileEntry_t;
+
+typedef struct
+{
+  unsigned long              ClearCount;
+  unsigned long              CopyCount;
+  runtimeInitProfileEntry_t  ClearTable[STARTUP_RAM_INIT_PROFILE_ENTRIES];
+  runtimeInitProfileEntry_t  CopyTable[STARTUP_RAM_INIT_PROFILE_ENTRIES];
+} runtimeInitProfile_t;
+
 //=========================================================================================
 // linker variables
 //=========================================================================================
 extern const runtimeCopyTable_t __RUNTIME_COPY_TABLE[];
+extern const runtimeCopyTable_t __RUNTIME_IMAGE_COPY_TABLE[];
 extern const runtimeClearTable_t __RUNTIME_CLEAR_TABLE[];
 extern unsigned long __CPPCTOR_LIST__[];
+extern unsigned long __BSS_LAZY_BASE_ADDRESS[];
+extern unsigned long __BSS_LAZY_END_ADDRESS[];
 
 //=========================================================================================
 // defines
 //=========================================================================================
 #define __STARTUP_RUNTIME_COPYTABLE   (runtimeCopyTable_t*)(&__RUNTIME_COPY_TABLE[0])
+#define __STARTUP_RUNTIME_IMAGETABLE  (runtimeCopyTable_t*)(&__RUNTIME_IMAGE_COPY_TABLE[0])
 #define __STARTUP_RUNTIME_CLEARTABLE  (runtimeClearTable_t*)(&__RUNTIME_CLEAR_TABLE[0])
 #define __STARTUP_RUNTIME_CTORS       (unsigned long*)(&__CPPCTOR_LIST__[0])
 
+#define STARTUP_BLOCK_SIZE            32UL
+#define STARTUP_WORD_SIZE             4UL
+
+#define STARTUP_COPY_FLAG_LZ4         0x80000000UL /* copy table size flag: source is an LZ4 block */
+#define STARTUP_LZ4_MINMATCH          4UL
+
+#define STARTUP_CORE1_RAM_INIT_DONE   0x52414D31UL /* 'RAM1' */
+
 //=========================================================================================
 // function prototype
 //=========================================================================================
-void Startup_Init(void) __attribute__((used));
-static void Startup_InitRam(void);
+void Startup_Init(void) __attribute__((used)) __boot_text;
+static void Startup_InitImage(void) __boot_text;
+static boolean Startup_InitRam(void);
 static void Startup_InitCtors(void);
 static void Startup_RunApplication(void);
 static void Startup_Unexpected_Exit(void);
-static void Startup_InitSystemClock(void);
+static void Startup_InitSystemClockStart(void);
+static boolean Startup_InitSystemClockStep(boolean ClockDone);
+static void Startup_InitSystemClockFinish(boolean ClockDone);
 static void Startup_InitCore(void);
+static void Startup_Lz4Decompress(unsigned long target, unsigned long source, unsigned long size);
+#if STARTUP_DUAL_CORE_RAM_INIT
+static void Startup_InitRamCore1(void);
+static unsigned long Startup_ClearTableSplit(unsigned long ClearTableIdx);
+#endif
+
+//=========================================================================================
+// globals
+//=========================================================================================
+/* RAM initialization profile (cycles per clear/copy table region), read it with the debugger */
+volatile runtimeInitProfile_t Startup_RamInitProfile;
+
+/* Background clear position inside the .bss_lazy section (0: not started) */
+static unsigned long Startup_LazyClearCursor;
 //=========================================================================================
 // extern function prototype
 //=========================================================================================
 int main(void) __attribute__((weak));
-void RP2350_ClockInit(void) __attribute__((weak));
+void RP2350_ClockInitStart(void) __attribute__((weak));
+boolean RP2350_ClockInitStep(void) __attribute__((weak));
+uint32 RP2350_ClockInitError(void) __attribute__((weak));
 void RP2350_InitCore(void) __attribute__((weak));
+#if STARTUP_DUAL_CORE_RAM_INIT
+boolean RP2350_LaunchCore1(pFunc EntryPoint);
+void RP2350_ResetCore1(void);
+void RP2350_FifoPush(uint32 Data);
+uint32 RP2350_FifoPop(void);
+#endif
 
 //=========================================================================================
 // macros
@@ -73,17 +151,44 @@ void RP2350_InitCore(void) __attribute__((weak));
 //-----------------------------------------------------------------------------------------
 void Startup_Init(void)
 {
+  boolean ClockDone;
+
+  /* Start the boot-stage trace (TIMER0 raw counter) */
+  BOOT_TRACE_INIT();
+
+  /* Copy the code to SRAM (copy_to_ram image mode only) */
+  Startup_InitImage();
+  BOOT_TRACE_MARK(BOOT_TRACE_INIT_IMAGE_DONE);
+
+  InitLevel_Run(INIT_LEVEL_EARLY);
+
   /* Initialize the CPU Core */
   Startup_InitCore();
+  BOOT_TRACE_MARK(BOOT_TRACE_INIT_CORE_DONE);
+
+  InitLevel_Run(INIT_LEVEL_PRE_CLOCK);
 
-  /* Configure the system clock */
-  Startup_InitSystemClock();
+  /* Start the system clock bring-up, it progresses while the RAM is initialized */
+  Startup_InitSystemClockStart();
+  BOOT_TRACE_MARK(BOOT_TRACE_INIT_CLOCK_START);
 
   /* Initialize the RAM memory */
-  Startup_InitRam();
+  ClockDone = Startup_InitRam();
+  BOOT_TRACE_MARK(BOOT_TRACE_INIT_RAM_DONE);
+
+  /* Wait for the end of the system clock bring-up */
+  Startup_InitSystemClockFinish(ClockDone);
+
+  /* Select the SRAM-resident vector table (RISC-V) */
+  CORE_ARCH_INIT_RAM_VECTORS();
+
+  InitLevel_Run(INIT_LEVEL_POST_CLOCK);
 
   /* Initialize the non-local C++ objects */
   Startup_InitCtors();
+  BOOT_TRACE_MARK(BOOT_TRACE_INIT_CTORS_DONE);
+
+  InitLevel_Run(INIT_LEVEL_APP);
 
   /* Start the application */
   Startup_RunApplication();
@@ -91,25 +196,87 @@ void Startup_Init(void)
 
 
 //-----------------------------------------------------------------------------------------
-/// \brief  Startup_InitRam function
+/// \brief  Startup_InitImage function
+///
+/// \descr  Process the image copy table: in the copy_to_ram image mode the .program and
+///         .rodata sections are copied from the flash to SRAM. The entries are empty in
+///         the xip image mode. Must run before any function outside of .boot_text.
 ///
 /// \param  void
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
-static void Startup_InitRam(void)
+static void Startup_InitImage(void)
 {
+  unsigned long ImageTableIdx = 0;
+
+  while((__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].sourceAddr != (unsigned long)-1 &&
+        (__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].targetAddr != (unsigned long)-1 &&
+        (__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].size       != (unsigned long)-1
+       )
+  {
+    Startup_MemCopy((__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].targetAddr,
+                    (__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].sourceAddr,
+                    (__STARTUP_RUNTIME_IMAGETABLE)[ImageTableIdx].size);
+
+    ImageTableIdx++;
+  }
+
+  CORE_ARCH_INSTRUCTION_SYNC();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_InitRam function
+///
+/// \descr  The system clock bring-up is advanced between the table entries.
+///
+/// \param  void
+///
+/// \return TRUE if the system clock bring-up finished during the RAM initialization
+//-----------------------------------------------------------------------------------------
+static boolean Startup_InitRam(void)
+{
+  boolean ClockDone = FALSE;
   unsigned long ClearTableIdx = 0;
   unsigned long CopyTableIdx  = 0;
+  unsigned long StartCycles;
+  runtimeInitProfileEntry_t ClearProfile[STARTUP_RAM_INIT_PROFILE_ENTRIES];
+  runtimeInitProfileEntry_t CopyProfile[STARTUP_RAM_INIT_PROFILE_ENTRIES];
+  unsigned long ClearSize;
+  unsigned long CopySize;
+
+  CORE_ARCH_CYCLE_COUNTER_INIT();
+
+#if STARTUP_DUAL_CORE_RAM_INIT
+  /* Launch core 1 on the RAM init stub, it clears the upper half of each region */
+  const boolean Core1Started = RP2350_LaunchCore1(&Startup_InitRamCore1);
+#endif
 
   /* Clear Table */
 
   while((__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr != (unsigned long)-1 && (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size != (unsigned long)-1)
   {
-    for(unsigned int cpt = 0; cpt < (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size; cpt++)
+    StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    ClearSize = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size;
+
+#if STARTUP_DUAL_CORE_RAM_INIT
+    if(TRUE == Core1Started)
     {
-      *(volatile unsigned char*)((unsigned long)((__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr) + cpt) = 0;
+      ClearSize = Startup_ClearTableSplit(ClearTableIdx) - (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr;
     }
+#endif
+
+    Startup_MemClear((__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr, ClearSize);
+
+    if(ClearTableIdx < STARTUP_RAM_INIT_PROFILE_ENTRIES)
+    {
+      ClearProfile[ClearTableIdx].cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+      ClearProfile[ClearTableIdx].Addr   = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr;
+      ClearProfile[ClearTableIdx].size   = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size;
+    }
+
+    ClockDone = Startup_InitSystemClockStep(ClockDone);
 
     ClearTableIdx++;
   }
@@ -121,14 +288,224 @@ static void Startup_InitRam(void)
         (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].size       != (unsigned long)-1
        )
   {
-    for(unsigned int cpt = 0; cpt < (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].size; cpt++)
+    StartCycles = CORE_ARCH_CYCLE_COUNTER_READ();
+
+    CopySize = (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].size & ~STARTUP_COPY_FLAG_LZ4;
+
+    if(((__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].size & STARTUP_COPY_FLAG_LZ4) != 0UL)
+    {
+      Startup_Lz4Decompress((__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].targetAddr,
+                            (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].sourceAddr,
+                            CopySize);
+    }
+    else
+    {
+      Startup_MemCopy((__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].targetAddr,
+                      (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].sourceAddr,
+                      CopySize);
+    }
+
+    if(CopyTableIdx < STARTUP_RAM_INIT_PROFILE_ENTRIES)
     {
-      *(volatile unsigned char*)((unsigned long)((__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].targetAddr) + cpt) = 
-               *(volatile unsigned char*)((unsigned long)((__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].sourceAddr) + cpt);
+      CopyProfile[CopyTableIdx].cycles = CORE_ARCH_CYCLE_COUNTER_READ() - StartCycles;
+      CopyProfile[CopyTableIdx].Addr   = (__STARTUP_RUNTIME_COPYTABLE)[CopyTableIdx].targetAddr;
+      CopyProfile[CopyTableIdx].size   = CopySize;
     }
 
+    ClockDone = Startup_InitSystemClockStep(ClockDone);
+
     CopyTableIdx++;
   }
+
+  /* the copy table holds code (.ramfunc) */
+  CORE_ARCH_INSTRUCTION_SYNC();
+
+#if STARTUP_DUAL_CORE_RAM_INIT
+  if(TRUE == Core1Started)
+  {
+    /* Barrier: wait until core 1 has cleared its halves */
+    while(RP2350_FifoPop() != STARTUP_CORE1_RAM_INIT_DONE);
+  }
+
+  /* Send core 1 back to the BootRom, the application starts it again later */
+  RP2350_ResetCore1();
+#endif
+
+  /* Publish the profile (the .bss is valid only from now on) */
+
+  Startup_RamInitProfile.ClearCount = ClearTableIdx;
+  Startup_RamInitProfile.CopyCount  = CopyTableIdx;
+
+  for(unsigned long idx = 0; (idx < ClearTableIdx) && (idx < STARTUP_RAM_INIT_PROFILE_ENTRIES); idx++)
+  {
+    Startup_RamInitProfile.ClearTable[idx].Addr   = ClearProfile[idx].Addr;
+    Startup_RamInitProfile.ClearTable[idx].size   = ClearProfile[idx].size;
+    Startup_RamInitProfile.ClearTable[idx].cycles = ClearProfile[idx].cycles;
+  }
+
+  for(unsigned long idx = 0; (idx < CopyTableIdx) && (idx < STARTUP_RAM_INIT_PROFILE_ENTRIES); idx++)
+  {
+    Startup_RamInitProfile.CopyTable[idx].Addr   = CopyProfile[idx].Addr;
+    Startup_RamInitProfile.CopyTable[idx].size   = CopyProfile[idx].size;
+    Startup_RamInitProfile.CopyTable[idx].cycles = CopyProfile[idx].cycles;
+  }
+
+  return(ClockDone);
+}
+
+#if STARTUP_DUAL_CORE_RAM_INIT
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_ClearTableSplit function
+///
+/// \descr  Split point of a clear table region: core 0 clears [Addr, split),
+///         core 1 clears [split, Addr + size).
+///
+/// \param  ClearTableIdx : index of the region in the clear table
+///
+/// \return the split address (word aligned, inside the region)
+//-----------------------------------------------------------------------------------------
+static unsigned long Startup_ClearTableSplit(unsigned long ClearTableIdx)
+{
+  const unsigned long Addr  = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr;
+  const unsigned long size  = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size;
+  const unsigned long split = (Addr + (size / 2UL)) & ~(STARTUP_WORD_SIZE - 1UL);
+
+  return((split < Addr) ? Addr : split);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_InitRamCore1 function
+///
+/// \descr  Minimal init stub executed by core 1 during the dual-core RAM init:
+///         clear the upper half of each clear table region then notify core 0.
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Startup_InitRamCore1(void)
+{
+  unsigned long ClearTableIdx = 0;
+
+  while((__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr != (unsigned long)-1 && (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size != (unsigned long)-1)
+  {
+    const unsigned long split = Startup_ClearTableSplit(ClearTableIdx);
+    const unsigned long end   = (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].Addr + (__STARTUP_RUNTIME_CLEARTABLE)[ClearTableIdx].size;
+
+    Startup_MemClear(split, end - split);
+
+    ClearTableIdx++;
+  }
+
+  RP2350_FifoPush(STARTUP_CORE1_RAM_INIT_DONE);
+
+  /* wait here until core 0 resets this core */
+  for(;;);
+}
+#endif
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_MemClear function
+///
+/// \descr  Alignment-aware clear: byte head up to the first word boundary,
+///         32-byte blocks (arch_block_clear), remaining words and byte tail.
+///
+/// \param  target : start address of the area to clear
+///         size   : length of the area (bytes)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Startup_MemClear(unsigned long target, unsigned long size)
+{
+#if STARTUP_RAM_INIT_BYTEWISE
+  for(unsigned long cpt = 0; cpt < size; cpt++)
+  {
+    *(volatile unsigned char*)(target + cpt) = 0;
+  }
+#else
+  /* byte head */
+  while(((target & (STARTUP_WORD_SIZE - 1UL)) != 0UL) && (size != 0UL))
+  {
+    *(volatile unsigned char*)target = 0;
+    target++;
+    size--;
+  }
+
+  /* 32-byte blocks */
+  arch_block_clear((uint32*)target, size / STARTUP_BLOCK_SIZE);
+  target += size & ~(STARTUP_BLOCK_SIZE - 1UL);
+  size   &= (STARTUP_BLOCK_SIZE - 1UL);
+
+  /* remaining words */
+  while(size >= STARTUP_WORD_SIZE)
+  {
+    *(volatile uint32*)target = 0UL;
+    target += STARTUP_WORD_SIZE;
+    size   -= STARTUP_WORD_SIZE;
+  }
+
+  /* byte tail */
+  while(size != 0UL)
+  {
+    *(volatile unsigned char*)target = 0;
+    target++;
+    size--;
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_MemCopy function
+///
+/// \descr  Alignment-aware copy: when source and target share the same word
+///         alignment, copy a byte head, 32-byte blocks (arch_block_copy),
+///         remaining words and a byte tail. Otherwise fall back to bytes.
+///
+/// \param  target : start address of the destination area
+///         source : start address of the source area
+///         size   : length of the area (bytes)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Startup_MemCopy(unsigned long target, unsigned long source, unsigned long size)
+{
+#if !STARTUP_RAM_INIT_BYTEWISE
+  if(((target ^ source) & (STARTUP_WORD_SIZE - 1UL)) == 0UL)
+  {
+    /* byte head */
+    while(((target & (STARTUP_WORD_SIZE - 1UL)) != 0UL) && (size != 0UL))
+    {
+      *(volatile unsigned char*)target = *(volatile unsigned char*)source;
+      target++;
+      source++;
+      size--;
+    }
+
+    /* 32-byte blocks */
+    arch_block_copy((uint32*)target, (const uint32*)source, size / STARTUP_BLOCK_SIZE);
+    target += size & ~(STARTUP_BLOCK_SIZE - 1UL);
+    source += size & ~(STARTUP_BLOCK_SIZE - 1UL);
+    size   &= (STARTUP_BLOCK_SIZE - 1UL);
+
+    /* remaining words */
+    while(size >= STARTUP_WORD_SIZE)
+    {
+      *(volatile uint32*)target = *(volatile uint32*)source;
+      target += STARTUP_WORD_SIZE;
+      source += STARTUP_WORD_SIZE;
+      size   -= STARTUP_WORD_SIZE;
+    }
+  }
+#endif
+
+  /* byte tail (or the whole area if the alignments differ) */
+  while(size != 0UL)
+  {
+    *(volatile unsigned char*)target = *(volatile unsigned char*)source;
+    target++;
+    source++;
+    size--;
+  }
 }
 
 //-----------------------------------------------------------------------------------------
@@ -181,15 +558,59 @@ static void Startup_Unexpected_Exit(void)
 }
 
 //-----------------------------------------------------------------------------------------
-/// \brief  Startup_InitSystemClock function
+/// \brief  Startup_InitSystemClockStart function
 ///
 /// \param  void
 ///
 /// \return void
 //-----------------------------------------------------------------------------------------
-static void Startup_InitSystemClock(void)
+static void Startup_InitSystemClockStart(void)
+{
+  RP2350_ClockInitStart();
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_InitSystemClockStep function
+///
+/// \descr  Advance the system clock bring-up without waiting (no-op once done).
+///
+/// \param  ClockDone : TRUE if the bring-up already finished
+///
+/// \return TRUE once the bring-up finished
+//-----------------------------------------------------------------------------------------
+static boolean Startup_InitSystemClockStep(boolean ClockDone)
+{
+  if((FALSE == ClockDone) && (TRUE == RP2350_ClockInitStep()))
+  {
+    BOOT_TRACE_MARK(BOOT_TRACE_INIT_CLOCK_DONE);
+    ClockDone = TRUE;
+  }
+
+  return(ClockDone);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_InitSystemClockFinish function
+///
+/// \descr  Wait for the end of the system clock bring-up. On a timeout the system
+///         stays here (the error code is given by RP2350_ClockInitError).
+///
+/// \param  ClockDone : TRUE if the bring-up already finished
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Startup_InitSystemClockFinish(boolean ClockDone)
 {
-  RP2350_ClockInit();
+  while(FALSE == ClockDone)
+  {
+    ClockDone = Startup_InitSystemClockStep(ClockDone);
+  }
+
+  if(RP2350_ClockInitError() != 0UL)
+  {
+    /* Loop forever in case of error */
+    for(;;);
+  }
 }
 
 //-----------------------------------------------------------------------------------------
@@ -203,3 +624,154 @@ void Startup_InitCore(void)
 {
   RP2350_InitCore();
 }
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_Lz4Decompress function
+///
+/// \descr  Decompress an LZ4 block (raw block format, no frame header) produced by
+///         the post-link step Tools/scripts/DataCompressLz4.py.
+///         Literal runs and non-overlapping matches use the block copy engine.
+///
+/// \param  target : start address of the destination area
+///         source : start address of the LZ4 block
+///         size   : decompressed length (bytes)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+static void Startup_Lz4Decompress(unsigned long target, unsigned long source, unsigned long size)
+{
+  const unsigned long end = target + size;
+
+  while(target < end)
+  {
+    const unsigned long token = *(volatile unsigned char*)source++;
+    unsigned long length = token >> 4;
+    unsigned long value;
+
+    /* literals */
+    if(length == 15UL)
+    {
+      do
+      {
+        value   = *(volatile unsigned char*)source++;
+        length += value;
+      } while(value == 255UL);
+    }
+
+    Startup_MemCopy(target, source, length);
+    target += length;
+    source += length;
+
+    /* the last sequence has only literals */
+    if(target >= end)
+    {
+      break;
+    }
+
+    /* match */
+    const unsigned long offset = (unsigned long)(*(volatile unsigned char*)source) | ((unsigned long)(*(volatile unsigned char*)(source + 1UL)) << 8);
+    source += 2UL;
+
+    length = token & 0x0FUL;
+
+    if(length == 15UL)
+    {
+      do
+      {
+        value   = *(volatile unsigned char*)source++;
+        length += value;
+      } while(value == 255UL);
+    }
+
+    length += STARTUP_LZ4_MINMATCH;
+
+    if(offset >= length)
+    {
+      Startup_MemCopy(target, target - offset, length);
+      target += length;
+    }
+    else
+    {
+      /* overlapping match (repeated pattern) */
+      while(length-- != 0UL)
+      {
+        *(volatile unsigned char*)target = *(volatile unsigned char*)(target - offset);
+        target++;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_LazyClear function
+///
+/// \descr  Clear on demand an object placed in the .bss_lazy section (__bss_lazy)
+///
+/// \param  object : start address of the object
+///         size   : length of the object (bytes)
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Startup_LazyClear(void* object, unsigned long size)
+{
+  Startup_MemClear((unsigned long)object, size);
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_LazyClearAll function
+///
+/// \descr  Clear the whole .bss_lazy section at once
+///
+/// \param  void
+///
+/// \return void
+//-----------------------------------------------------------------------------------------
+void Startup_LazyClearAll(void)
+{
+  while(FALSE == Startup_LazyClearStep((unsigned long)__BSS_LAZY_END_ADDRESS - (unsigned long)__BSS_LAZY_BASE_ADDRESS));
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_LazyClearStep function
+///
+/// \descr  Clear the next chunk of the .bss_lazy section, intended to be called
+///         repeatedly from the idle loop of a core. The objects of the section
+///         must not be used before Startup_LazyIsCleared() returns TRUE.
+///         Must be called from one core only.
+///
+/// \param  chunk : maximum number of bytes to clear in this step
+///
+/// \return TRUE when the whole section is cleared
+//-----------------------------------------------------------------------------------------
+boolean Startup_LazyClearStep(unsigned long chunk)
+{
+  const unsigned long end = (unsigned long)__BSS_LAZY_END_ADDRESS;
+
+  if(Startup_LazyClearCursor == 0UL)
+  {
+    Startup_LazyClearCursor = (unsigned long)__BSS_LAZY_BASE_ADDRESS;
+  }
+
+  if((end - Startup_LazyClearCursor) < chunk)
+  {
+    chunk = end - Startup_LazyClearCursor;
+  }
+
+  Startup_MemClear(Startup_LazyClearCursor, chunk);
+
+  Startup_LazyClearCursor += chunk;
+
+  return(Startup_LazyIsCleared());
+}
+
+//-----------------------------------------------------------------------------------------
+/// \brief  Startup_LazyIsCleared function
+///
+/// \param  void
+///
+/// \return TRUE when the background clear of the .bss_lazy section is complete
+//-----------------------------------------------------------------------------------------
+boolean Startup_LazyIsCleared(void)
+{
+  return((Startup_LazyClearCursor >= (unsigned long)__BSS_LAZY_END_ADDRESS) ? TRUE : FALSE);
+}
@@ -0,0 +1,39 @@
+// ***************************************************************************************
+// Filename    : Startup.h
+//
+// Author      : Chalandi Amine
+//
+// Owner       : Chalandi Amine
+// 
+// Date        : 04.09.2024
+// 
+// Description : C/C++ Runtime Setup (Crt0) header file
+// 
+// ***************************************************************************************
+
+#ifndef __STARTUP_H__
+#define __STARTUP_H__
+
+//=========================================================================================
+// includes
+//=========================================================================================
+#include "Platform_Types.h"
+#include "Compiler.h"
+
+//=========================================================================================
+// defines
+//=========================================================================================
+/* Default chunk size for the background clear of the .bss_lazy section (bytes) */
+#define STARTUP_LAZY_CLEAR_CHUNK   4096UL
+
+//=========================================================================================
+// function prototype
+//=========================================================================================
+void    Startup_MemClear(unsigned long target, unsigned long size);
+void    Startup_MemCopy(unsigned long target, unsigned long source, unsigned long size) __boot_text;
+void    Startup_LazyClear(void* object, unsigned long size);
+void    Startup_LazyClearAll(void);
+boolean Startup_LazyClearStep(unsigned long chunk);
+boolean Startup_LazyIsCleared(void);
+
+#endif /*__STARTUP_H__*/
@@ -0,0 +1,40 @@
+/******************************************************************************************
+  Filename    : Compiler.h
+  
+  Core        : ARM Cortex-M33 / RISC-V Hazard3
+  
+  MCU         : RP2350
+    
+  Author      : Chalandi Amine
+ 
+  Owner       : Chalandi Amine
+  
+  Date        : 04.09.2024
+  
+  Description : Compiler abstraction (section placement attributes)
+  
+******************************************************************************************/
+
+#ifndef __COMPILER_H__
+#define __COMPILER_H__
+
+/* Object never initialized by the startup code (content survives a warm reset) */
+#define __noinit     __attribute__((section(".noinit")))
+
+/* Object excluded from the startup clear table, clear it with Startup_LazyClear*() */
+#define __bss_lazy   __attribute__((section(".bss.lazy")))
+
+/* Function executed from SRAM (copied by the startup code, no XIP cache dependency) */
+#define __time_critical   __attribute__((section(".ramfunc"), noinline))
+
+/* Core-private hot data in the scratch banks (SCRATCH_X: core 0, SCRATCH_Y: core 1) */
+#define __scratch_x   __attribute__((section(".scratch_x")))
+#define __scratch_y   __attribute__((section(".scratch_y")))
+
+/* Function always executed from the flash (runs before the image copy in the copy_to_ram image mode) */
+#define __boot_text       __attribute__((section(".boot_text"), noinline))
+
+/* Function inlined even without optimization (the image is built with -O0) */
+#define __force_inline    inline __attribute__((always_inline))
+
+#endif /*__COMPILER_H__*/
@@ -0,0 +1,134 @@
+#####################################################################################
+#
+# Filename    : BootTraceDecoder.py
+#
+# Author      : Chalandi Amine
+#
+# Owner       : Chalandi Amine
+#
+# Date        : 04.09.2024
+#
+# Description : Decode the boot-stage trace record (Code/Startup/BootTrace.h)
+#               from a binary RAM dump and print the duration of each stage.
+#
+#               RAM dump examples:
+#                 picotool save -r 0x20000000 0x20082000 ram.bin
+#                 (gdb) dump binary memory ram.bin 0x20000000 0x20082000
+#
+#               The record is searched in the dump by its magic word unless its
+#               offset inside the dump is given (see BootTrace_Record in the .sym file).
+#
+#####################################################################################
+
+import sys
+import struct
+
+# Command-line syntax :  py  BootTraceDecoder.py  <RamDump.bin>  [<RecordOffset>]
+
+BOOT_TRACE_MAGIC        = 0x54425442
+BOOT_TRACE_VERSION      = 3
+BOOT_TRACE_NOT_RECORDED = 0xFFFFFFFF
+
+# marks (same order as bootTraceMark_t)
+MARKS = [ 'STARTUP_ENTRY',
+          'INIT_CORE_DONE',
+          'INIT_CLOCK_DONE',
+          'INIT_RAM_DONE',
+          'INIT_CTORS_DONE',
+          'START_CORE1_ENTRY',
+          'START_CORE1_DONE',
+          'CORE1_ENTRY',
+          'SYNC_CORE0_ENTRY',
+          'SYNC_CORE0_DONE',
+          'SYNC_CORE1_ENTRY',
+          'SYNC_CORE1_DONE',
+          'INIT_IMAGE_DONE',
+          'INIT_CLOCK_START' ]
+
+# stages : (name, start mark, end mark), a tuple of marks stands for the latest of them
+STAGES = [ ('Startup_InitImage (*)',       'STARTUP_ENTRY',     'INIT_IMAGE_DONE'),
+           ('Startup_InitCore (*)',        'INIT_IMAGE_DONE',   'INIT_CORE_DONE'),
+           ('init level PRE_CLOCK (*)',    'INIT_CORE_DONE',    'INIT_CLOCK_START'),
+           ('system clock bring-up (*)',   'INIT_CLOCK_START',  'INIT_CLOCK_DONE'),
+           ('Startup_InitRam (overlapped)','INIT_CLOCK_START',  'INIT_RAM_DONE'),
+           ('Startup_InitCtors',           ('INIT_RAM_DONE', 'INIT_CLOCK_DONE'), 'INIT_CTORS_DONE'),
+           ('main_Core0 (until core 1)',   'INIT_CTORS_DONE',   'START_CORE1_ENTRY'),
+           ('RP2350_StartCore1',           'START_CORE1_ENTRY', 'START_CORE1_DONE'),
+           ('core 1 launch to main_Core1', 'START_CORE1_ENTRY', 'CORE1_ENTRY'),
+           ('RP2350_MulticoreSync core 0', 'SYNC_CORE0_ENTRY',  'SYNC_CORE0_DONE'),
+           ('RP2350_MulticoreSync core 1', 'SYNC_CORE1_ENTRY',  'SYNC_CORE1_DONE') ]
+
+#------------------------------------------------------------------------------------
+# find the record
+#------------------------------------------------------------------------------------
+def FindRecord(dump):
+    for offset in range(0, len(dump) - 12, 4):
+        magic, version, count = struct.unpack_from('<3I', dump, offset)
+        if (magic == BOOT_TRACE_MAGIC) and (version == BOOT_TRACE_VERSION) and (count == len(MARKS)):
+            return offset
+    return None
+
+#------------------------------------------------------------------------------------
+# time stamp of a mark (or of the latest of a tuple of marks)
+#------------------------------------------------------------------------------------
+def Stamp(stamps, mark):
+    marks = mark if isinstance(mark, tuple) else (mark,)
+    if any(stamps[m] == BOOT_TRACE_NOT_RECORDED for m in marks):
+        return BOOT_TRACE_NOT_RECORDED
+    base = stamps['STARTUP_ENTRY']
+    return max([stamps[m] for m in marks], key=lambda t: (t - base) & 0xFFFFFFFF)
+
+#------------------------------------------------------------------------------------
+# main
+#------------------------------------------------------------------------------------
+if len(sys.argv) not in (2, 3):
+    print("Command-line syntax :  py  BootTraceDecoder.py  <RamDump.bin>  [<RecordOffset>]")
+    sys.exit(1)
+
+dump = open(sys.argv[1], 'rb').read()
+
+if len(sys.argv) == 3:
+    offset = int(sys.argv[2], 0)
+else:
+    offset = FindRecord(dump)
+
+if (offset is None) or ((offset + 12 + 4 * len(MARKS)) > len(dump)):
+    print("Error: no boot trace record found in %s" % sys.argv[1])
+    sys.exit(1)
+
+magic, version, count = struct.unpack_from('<3I', dump, offset)
+
+if (magic != BOOT_TRACE_MAGIC) or (version != BOOT_TRACE_VERSION) or (count != len(MARKS)):
+    print("Error: invalid boot trace record at offset 0x%X" % offset)
+    sys.exit(1)
+
+stamps = dict(zip(MARKS, struct.unpack_from('<%dI' % count, dump, offset + 12)))
+
+print("boot trace record at offset 0x%X" % offset)
+print("")
+print("%-32s %12s %12s" % ('stage', 'us', 'end (us)'))
+print("-" * 58)
+
+base = stamps['STARTUP_ENTRY']
+
+for name, start, end in STAGES:
+    t0 = Stamp(stamps, start)
+    t1 = Stamp(stamps, end)
+    if (t0 == BOOT_TRACE_NOT_RECORDED) or (t1 == BOOT_TRACE_NOT_RECORDED):
+        print("%-32s %12s %12s" % (name, 'n/a', 'n/a'))
+    else:
+        print("%-32s %12d %12d" % (name, (t1 - t0) & 0xFFFFFFFF, (t1 - base) & 0xFFFFFFFF))
+
+done = [stamps[m] for m in ('SYNC_CORE0_DONE', 'SYNC_CORE1_DONE') if stamps[m] != BOOT_TRACE_NOT_RECORDED]
+
+print("-" * 58)
+if done:
+    print("%-32s %12d" % ('total (entry to multicore sync)', (max(done) - base) & 0xFFFFFFFF))
+
+# the RAM init runs while the clock settles: the overlap is the time saved versus a serial bring-up
+if all(stamps[m] != BOOT_TRACE_NOT_RECORDED for m in ('INIT_CLOCK_START', 'INIT_CLOCK_DONE', 'INIT_RAM_DONE')):
+    start = stamps['INIT_CLOCK_START']
+    print("%-32s %12d" % ('clock/RAM init overlap (saved)', min((stamps['INIT_CLOCK_DONE'] - start) & 0xFFFFFFFF,
+                                                                (stamps['INIT_RAM_DONE']   - start) & 0xFFFFFFFF)))
+print("")
+print("(*) clk_ref runs from the ROSC until the XOSC switch: approximate duration")
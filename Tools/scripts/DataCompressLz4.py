@@ -0,0 +1,206 @@
+#####################################################################################
+#
+# Filename    : DataCompressLz4.py
+#
+# Author      : Chalandi Amine
+#
+# Owner       : Chalandi Amine
+#
+# Date        : 04.09.2024
+#
+# Description : Post-link step: LZ4-compress the .data load image of an ELF file
+#               linked with --defsym=__DATA_LZ4=1 (see Memory_Map.ld).
+#
+#               - the .data content is compressed (LZ4 block format) into the
+#                 reserved .data_lz4 section (first word = compressed size),
+#               - .data_lz4 and its flash segment are trimmed to the real size,
+#               - .data becomes NOBITS so that it no longer occupies the flash image.
+#
+#               The copy table entry of .data already points to the LZ4 block and
+#               carries the compressed flag (set by the linker script). .data must
+#               be the last load region of the flash image (checked here and by an
+#               ASSERT of Memory_Map.ld).
+#
+#####################################################################################
+
+import sys
+import struct
+
+# Command-line syntax :  py  DataCompressLz4.py  <ElfFile>
+
+SHT_NOBITS    = 8
+LZ4_MINMATCH  = 4
+LZ4_LASTLITERALS = 5
+LZ4_MFLIMIT   = 12
+LZ4_MAXOFFSET = 65535
+
+#------------------------------------------------------------------------------------
+# LZ4 block compressor (greedy, hash of 4-byte sequences)
+#------------------------------------------------------------------------------------
+def Lz4WriteLength(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+def Lz4EmitSequence(out, src, anchor, pos, offset, matchlen):
+    litlen = pos - anchor
+    token  = (min(litlen, 15) << 4) | (min(matchlen - LZ4_MINMATCH, 15) if offset else 0)
+    out.append(token)
+    if litlen >= 15:
+        Lz4WriteLength(out, litlen - 15)
+    out += src[anchor:pos]
+    if offset:
+        out += struct.pack('<H', offset)
+        if (matchlen - LZ4_MINMATCH) >= 15:
+            Lz4WriteLength(out, matchlen - LZ4_MINMATCH - 15)
+
+def Lz4Compress(src):
+    out    = bytearray()
+    table  = {}
+    size   = len(src)
+    anchor = 0
+    pos    = 0
+    limit  = size - LZ4_MFLIMIT
+
+    while pos < limit:
+        seq  = src[pos:pos + 4]
+        cand = table.get(seq)
+        table[seq] = pos
+        if (cand is not None) and ((pos - cand) <= LZ4_MAXOFFSET):
+            matchlen = LZ4_MINMATCH
+            maxlen   = size - LZ4_LASTLITERALS - pos
+            while (matchlen < maxlen) and (src[cand + matchlen] == src[pos + matchlen]):
+                matchlen += 1
+            Lz4EmitSequence(out, src, anchor, pos, pos - cand, matchlen)
+            pos   += matchlen
+            anchor = pos
+        else:
+            pos += 1
+
+    # last literals
+    Lz4EmitSequence(out, src, anchor, size, 0, 0)
+    return bytes(out)
+
+def Lz4Decompress(src, size):
+    out = bytearray()
+    pos = 0
+    while len(out) < size:
+        token  = src[pos]; pos += 1
+        litlen = token >> 4
+        if litlen == 15:
+            while True:
+                b = src[pos]; pos += 1
+                litlen += b
+                if b != 255:
+                    break
+        out += src[pos:pos + litlen]; pos += litlen
+        if len(out) >= size:
+            break
+        offset = src[pos] | (src[pos + 1] << 8); pos += 2
+        matchlen = (token & 0x0F)
+        if matchlen == 15:
+            while True:
+                b = src[pos]; pos += 1
+                matchlen += b
+                if b != 255:
+                    break
+        matchlen += LZ4_MINMATCH
+        for _ in range(matchlen):
+            out.append(out[-offset])
+    return bytes(out)
+
+#------------------------------------------------------------------------------------
+# minimal ELF32 little-endian access
+#------------------------------------------------------------------------------------
+def ElfSections(elf):
+    e_shoff, = struct.unpack_from('<I', elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+    shdrs = []
+    for idx in range(e_shnum):
+        shdrs.append(list(struct.unpack_from('<10I', elf, e_shoff + idx * e_shentsize)))
+    strtab_off = shdrs[e_shstrndx][4]
+    sections = {}
+    for idx, sh in enumerate(shdrs):
+        name_end = elf.index(b'\0', strtab_off + sh[0])
+        name     = elf[strtab_off + sh[0]:name_end].decode()
+        sections[name] = (idx, sh)
+    return e_shoff, e_shentsize, sections
+
+def ElfSegments(elf):
+    e_phoff, = struct.unpack_from('<I', elf, 0x1C)
+    e_phentsize, e_phnum = struct.unpack_from('<HH', elf, 0x2A)
+    return [(e_phoff + idx * e_phentsize, list(struct.unpack_from('<8I', elf, e_phoff + idx * e_phentsize))) for idx in range(e_phnum)]
+
+#------------------------------------------------------------------------------------
+# main
+#------------------------------------------------------------------------------------
+if len(sys.argv) != 2:
+    print("Command-line syntax :  py  DataCompressLz4.py  <ElfFile>")
+    sys.exit(1)
+
+ElfFile = sys.argv[1]
+elf     = bytearray(open(ElfFile, 'rb').read())
+
+e_shoff, e_shentsize, sections = ElfSections(elf)
+
+if ('.data' not in sections) or ('.data_lz4' not in sections):
+    print("Error: the ELF file has no .data/.data_lz4 section")
+    sys.exit(1)
+
+data_idx, data_sh = sections['.data']
+lz4_idx,  lz4_sh  = sections['.data_lz4']
+
+if data_sh[1] == SHT_NOBITS:
+    print("Error: .data is already compressed")
+    sys.exit(1)
+
+# the trimming below leaves a hole in the flash image if anything is loaded behind .data
+# (checked by the linker script too)
+data_lma = None
+
+for ph_off, ph in ElfSegments(elf):
+    if (ph[2] <= data_sh[3]) and ((data_sh[3] + data_sh[5]) <= (ph[2] + ph[4])) and (ph[4] != 0):
+        data_lma = ph[3] + (data_sh[3] - ph[2])
+
+if (data_lma is None) or any((ph[4] != 0) and (ph[3] > data_lma) for ph_off, ph in ElfSegments(elf)):
+    print("Error: .data is not the last load region of the flash image")
+    sys.exit(1)
+
+data       = bytes(elf[data_sh[4]:data_sh[4] + data_sh[5]])
+compressed = Lz4Compress(data)
+
+if Lz4Decompress(compressed, len(data)) != data:
+    print("Error: LZ4 round-trip check failed")
+    sys.exit(1)
+
+block = struct.pack('<I', len(compressed)) + compressed
+block = block + bytes((4 - (len(block) % 4)) % 4)
+
+if len(block) > lz4_sh[5]:
+    print("Error: the reserved .data_lz4 section is too small")
+    sys.exit(1)
+
+trim = lz4_sh[5] - len(block)
+
+# fill the .data_lz4 section and trim it (and its segment) to the real size
+elf[lz4_sh[4]:lz4_sh[4] + lz4_sh[5]] = block + bytes(trim)
+
+for ph_off, ph in ElfSegments(elf):
+    if (ph[1] <= lz4_sh[4]) and ((lz4_sh[4] + lz4_sh[5]) == (ph[1] + ph[4])):
+        ph[4] -= trim
+        ph[5] -= trim
+        struct.pack_into('<8I', elf, ph_off, *ph)
+    elif (ph[2] <= data_sh[3]) and ((data_sh[3] + data_sh[5]) == (ph[2] + ph[4])) and (ph[4] != 0):
+        # .data (last section of its segment) is no longer loaded from the flash image
+        ph[4] -= data_sh[5]
+        struct.pack_into('<8I', elf, ph_off, *ph)
+
+lz4_sh[5]  = len(block)
+data_sh[1] = SHT_NOBITS
+struct.pack_into('<10I', elf, e_shoff + lz4_idx  * e_shentsize, *lz4_sh)
+struct.pack_into('<10I', elf, e_shoff + data_idx * e_shentsize, *data_sh)
+
+open(ElfFile, 'wb').write(elf)
+
+print("+++ info: .data load image compressed from %d to %d bytes (lz4)" % (len(data), len(block)))
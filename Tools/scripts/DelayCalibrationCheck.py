@@ -0,0 +1,103 @@
+#####################################################################################
+#
+# Filename    : DelayCalibrationCheck.py
+#
+# Author      : Chalandi Amine
+#
+# Owner       : Chalandi Amine
+#
+# Date        : 04.09.2024
+#
+# Description : Check the ns to cycles calibration table of the delay driver
+#               (Delay_CalibrationTable in Code/Mcal/Delay/Delay.c) on the host.
+#
+#               The table holds literal Q32 multipliers, each entry documents the
+#               expected cycles of 1 us ("/* 1 us = <n> cycles */"). For every entry
+#               the literal multiplier must give exactly <n> cycles for 1 us and
+#               1000 * <n> cycles for 1 ms, and the conversion error of Delay_Ns must
+#               stay within (-1, +1] cycle up to the longest inline delay
+#               (DELAY_US_INLINE_MAX). The literal must also match DELAY_NS_MUL
+#               (boot value of Delay_NsMul) and the runtime fallback
+#               (RP2350_ClockScale) used for the frequencies missing in the table.
+#
+#####################################################################################
+
+import os
+import re
+import sys
+
+# Command-line syntax :  py  DelayCalibrationCheck.py  [<Delay.c>]
+
+DELAY_NS_MAX = 1000000 * 1000   # DELAY_US_INLINE_MAX in ns
+
+NS_SAMPLES = [ 1, 10, 50, 100, 333, 1000, 4096, 10000, 33333, 100000,
+               999999, 1000000, 12345678, 100000000, DELAY_NS_MAX - 1 ]
+
+#------------------------------------------------------------------------------------
+# DELAY_NS_MUL(hz) : ceil(hz * 2^32 / 10^9)
+#------------------------------------------------------------------------------------
+def NsMul(hz):
+    return ((hz << 32) + 999999999) // 1000000000
+
+#------------------------------------------------------------------------------------
+# Delay_NsMulForFreq fallback : RP2350_ClockScale(hz, 2^31, 5 * 10^8) + 1
+#------------------------------------------------------------------------------------
+def NsMulFallback(hz):
+    return ((hz * 0x80000000) // 500000000) + 1
+
+#------------------------------------------------------------------------------------
+# worst conversion error in cycles (Delay_Ns versus the exact ns * hz / 10^9)
+#------------------------------------------------------------------------------------
+def ErrorRange(hz, mul):
+    errors = []
+    for ns in NS_SAMPLES + [DELAY_NS_MAX]:
+        cycles = (ns * mul) >> 32
+        errors.append(cycles - (ns * hz / 1e9))
+    return min(errors), max(errors)
+
+#------------------------------------------------------------------------------------
+# main
+#------------------------------------------------------------------------------------
+if len(sys.argv) not in (1, 2):
+    print("Command-line syntax :  py  DelayCalibrationCheck.py  [<Delay.c>]")
+    sys.exit(1)
+
+if len(sys.argv) == 2:
+    source = sys.argv[1]
+else:
+    source = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'Code', 'Mcal', 'Delay', 'Delay.c')
+
+table = [(int(hz), int(mul), int(us)) for hz, mul, us in
+         re.findall(r'\{\s*(\d+)UL,\s*(\d+)UL\s*\},?\s*/\*\s*1 us = (\d+) cycles', open(source).read())]
+
+if (not table) or (len(table) != len(re.findall(r'\{\s*\d+UL,\s*\d+UL\s*\}', open(source).read()))):
+    print("Error: calibration entries without the expected 1 us cycles in %s" % source)
+    sys.exit(1)
+
+failures = 0
+
+print("%12s %12s %8s %12s %12s %12s" % ('clk_sys (Hz)', 'NsMul', '1 us', 'fallback', 'err min', 'err max'))
+print("-" * 76)
+
+for hz, mul, us in table:
+    fallback = NsMulFallback(hz)
+    low, high = ErrorRange(hz, mul)
+
+    ok = ((mul < (1 << 32))                       and
+          (((1000 * mul) >> 32) == us)             and
+          (((1000000 * mul) >> 32) == (1000 * us)) and
+          (low > -1.0) and (high <= 1.0)           and
+          (mul == NsMul(hz))                       and
+          (abs(fallback - mul) <= 1))
+
+    print("%12d %12d %8d %12d %12.3f %12.3f %s" % (hz, mul, (1000 * mul) >> 32, fallback, low, high, '' if ok else '<- FAILED'))
+
+    failures += 0 if ok else 1
+
+print("-" * 76)
+
+if failures:
+    print("%d calibration entries out of tolerance" % failures)
+    sys.exit(1)
+
+print("%d calibration entries within (-1, +1] cycle" % len(table))